@@ -1,5 +1,39 @@
+#define _DEFAULT_SOURCE // Exposes madvise and the other POSIX functions when compiled with a strict -std
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <pthread.h>
+#include <math.h>
+#include <time.h>
+
+#ifndef _WIN32 // Binary traces are memory-mapped where mmap exists, otherwise they are read in chunks
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#endif
+
+#define TRACE_MAGIC "OSTR" // First 4 bytes of a binary trace file
+#define TRACE_VERSION 1
+#define TRACE_CHUNK_RECORDS 4096 // Records read at a time when a binary trace cannot be memory-mapped
+#define TRACE_LINE_LENGTH 256
+#define OUTPUT_BUFFER_SIZE (1 << 20) // Buffered output is written to stdout in chunks of this size
+#define HISTOGRAM_SUB_BUCKETS 16 // Buckets per power of two, so a percentile is within 1/16 of the exact value
+#define HISTOGRAM_BUCKETS (28 * HISTOGRAM_SUB_BUCKETS) // Enough buckets for every non-negative int
+#define BENCHMARK_MINIMUM_PROCESSES 1000 // Smallest workload of the benchmark, which grows 10 times per step
+#define BENCHMARK_MEAN_BURST_TIME 10.0
+#define BENCHMARK_LOAD 0.9 // Fraction of time the CPU is busy on average, so queues form without growing forever
+#define WINDOW_STEPS 4 // An open system reports its window every quarter of the window length, so consecutive windows overlap
+#define MLFQ_MAXIMUM_LEVELS 32 // One bit per level in the bitmap of the Feedback Queues
+#define MLFQ_DEFAULT_BOOST_PERIOD 100
+#define TUNING_RING_CAPACITY 16 // Starting size of the Ready Queue of each group of the autotuner
+#define CFS_NICE_0_WEIGHT 1024 // Weight of a MEDIUM priority process in the Completely Fair Scheduler
+#define CFS_LATENCY_GRANULARITIES 8 // Targeted latency of the Completely Fair Scheduler, in minimum granularities (time quantums)
 
 enum Priority{ // For use in priority of processes
 	LOW = 3,
@@ -7,13 +41,246 @@ enum Priority{ // For use in priority of processes
 	HIGH = 1
 };
 
-enum SortingMetric{ // For use in linked list insertions
-	LEASTARRIVALTIME,
-	LEASTBURSTTIME,
-	HIGHESTPRIORITY,
-	PROCESSID
+// Every sorting metric is listed once here as METRIC(name, key it is sorted by, key used as tie-break)
+// Each line generates the enum value and its own specialized insert functions, so adding a metric is adding a line
+#define SORTING_METRICS(METRIC) \
+	METRIC(LEASTARRIVALTIME, process->arrivalTime, process->arrivalTime) /* Process that arrived first will be ahead */ \
+	METRIC(LEASTBURSTTIME, process->burstTime, process->arrivalTime) /* If same burst time, then apply FCFS */ \
+	METRIC(HIGHESTPRIORITY, process->priority, process->arrivalTime) /* HIGH is 1, so the lowest value is the highest priority */ \
+	METRIC(PROCESSID, process->processID, 0) /* Does not apply FCFS, only the original order of input */ \
+	METRIC(LEASTREMAININGTIME, process->remainingTime, process->arrivalTime) /* If same remaining time, then apply FCFS */
+
+#define DECLARE_METRIC_ENUM(metric, primaryKeyOfProcess, secondaryKeyOfProcess) metric,
+enum SortingMetric{ // For use in Ready Queue insertions
+	SORTING_METRICS(DECLARE_METRIC_ENUM)
+	NUMBEROFSORTINGMETRICS
+};
+
+enum ClockMode{ // For use in advancing time while CPU is idle
+	UNITCLOCK, // Time increases by 1 per idle box in the Gantt Chart
+	EVENTCLOCK // Time jumps straight to the next arrival, so the whole idle period is one box in the Gantt Chart
+};
+
+enum OutputMode{ // For use in deciding what algorithms print
+	TEXTOUTPUT, // Gantt Chart, Table of Processes and averages are printed
+	QUIETOUTPUT, // Only the averages (and the headers saying which algorithm they belong to) are printed
+	BUFFEREDOUTPUT, // Same as TEXTOUTPUT, but text is gathered in a large buffer and written in chunks
+	BINARYOUTPUT, // Averages are printed, while the Gantt Chart is written to a file as GanttRecords
+	SILENTOUTPUT // Nothing is printed, results are only returned (used when algorithms run in parallel)
+};
+
+enum SchedulingAlgorithm{ // For use in choosing an algorithm at runtime
+	FCFS,
+	FCFSNOIDLE,
+	ROUNDROBIN,
+	ROUNDROBINNOIDLE,
+	SJF,
+	SRTF,
+	PRIORITY,
+	MLFQ,
+	CFS
+};
+
+enum PlacementPolicy{ // For use in choosing the Run Queue of an arriving process when there are several CPUs
+	ROUNDROBINPLACEMENT, // Arrivals are given to each CPU in turn
+	LEASTLOADEDPLACEMENT, // Arrivals go to the CPU with the fewest processes, running or waiting
+	SINGLEPLACEMENT // Every arrival goes to the first CPU, so other CPUs only get work by stealing
+};
+
+enum WorkloadPattern{ // For use in generating synthetic workloads
+	POISSONWORKLOAD, // Arrivals are a Poisson process and burst times are exponential
+	HEAVYTAILEDWORKLOAD, // Arrivals are a Poisson process, but burst times follow a Pareto distribution (few very long jobs)
+	BURSTYWORKLOAD, // Processes arrive in dense waves separated by quiet periods
+	ALLWORKLOADS // Benchmark runs every pattern
+};
+
+const char *workloadNames[] = {"poisson", "heavy-tailed", "bursty"};
+
+enum TuningObjective{ // For use in choosing the best time quantum, which is the one with the lowest value
+	AVERAGEWAITINGOBJECTIVE,
+	P99TURNAROUNDOBJECTIVE,
+	CONTEXTSWITCHOBJECTIVE // Times the CPU starts running a different process than the one it ran last
 };
 
+const char *objectiveNames[] = {"waiting", "p99-turnaround", "switches"};
+
+const char *placementNames[] = {"round-robin", "least-loaded", "single"};
+
+const char *algorithmNames[] = {"FCFS", "FCFS (no idle)", "Round Robin", "Round Robin (no idle)", "SJF", "SRTF", "Priority (preemptive)", "MLFQ", "CFS"};
+
+struct SimulationOptions{
+	enum ClockMode clockMode;
+	enum OutputMode outputMode;
+	char *tracePath; // If not NULL, processes are loaded from this trace instead of the built-in test cases
+	char *binaryTracePath; // If not NULL, the loaded trace is converted to a binary trace at this path
+	char *ganttPath; // File where the Gantt Chart is written in BINARYOUTPUT
+	int streamTrace; // If 1, the trace is fed to the scheduler while it is read instead of being loaded first
+	int timeQuantum;
+	int sweepMinimumQuantum; // If greater than zero, every algorithm and every quantum in this range is run in parallel
+	int sweepMaximumQuantum;
+	int numberOfThreads; // Workers used by the sweep, 0 means one per CPU
+	int numberOfCpus; // If greater than zero, algorithms are run on this many simulated CPUs, each with its own Run Queue
+	enum PlacementPolicy placementPolicy;
+	int workStealing; // If 1, a CPU with nothing to execute takes a waiting process from the longest Run Queue
+	int benchmarkMaximumProcesses; // If greater than zero, every algorithm is timed on generated workloads of up to this many processes
+	int generatedProcesses; // If greater than zero, a generated workload of this many processes is written to generatedPath
+	char *generatedPath;
+	enum WorkloadPattern workloadPattern;
+	uint64_t seed; // Seed of the workload generator, so that every run generates the same workload
+	int openDuration; // If greater than zero, algorithms run as an open system for this much simulated time
+	int windowLength; // Length of the sliding window over which the open system reports its metrics
+	int autotuneMinimumQuantum; // If greater than zero, Round Robin is tuned over the time quantums in this range
+	int autotuneMaximumQuantum;
+	enum TuningObjective tuningObjective;
+	int mlfqLevels; // If greater than zero, the Multilevel Feedback Queue has this many levels with the time quantums below
+	int mlfqTimeQuanta[MLFQ_MAXIMUM_LEVELS];
+	int mlfqBoostPeriod; // Every process goes back to the highest level at multiples of this time, 0 means never
+}; // struct for the options given in the command line, shared by every algorithm
+
+struct SimulationOptions simulationOptions = {UNITCLOCK, TEXTOUTPUT, NULL, NULL, NULL, 0, 3, 0, 0, 0, 0, LEASTLOADEDPLACEMENT, 1, 0, 0, NULL, ALLWORKLOADS, 1, 0, 1000, 0, 0, AVERAGEWAITINGOBJECTIVE, 0, {0}, MLFQ_DEFAULT_BOOST_PERIOD};
+
+struct GanttRecord{
+	int32_t startTime;
+	int32_t endTime;
+	int32_t processID; // 0 if CPU was idle
+}; // struct for one box of a binary Gantt Chart, where a record of -1s marks the end of one algorithm
+
+struct OutputState{
+	char *buffer; // Text waiting to be written in BUFFEREDOUTPUT
+	size_t bufferUsed;
+	FILE *ganttFile; // Opened in BINARYOUTPUT
+	struct GanttRecord pendingSlice; // Last box of the binary Gantt Chart, kept so that the next box can be merged into it
+	int hasPendingSlice;
+}; // struct for the state of the output functions
+
+struct OutputState outputState = {NULL, 0, NULL, {0, 0, 0}, 0};
+
+struct SchedulingResult{
+	int totalCompletionTime;
+	long long totalTurnaroundTime;
+	long long totalWaitingTime;
+	long numberOfProcesses;
+	long long numberOfEvents; // Passes of the scheduling loop (slices, idle periods or events in multi-core mode), used by the benchmark
+	int percentile99WaitingTime;
+}; // struct for the results of one run of an algorithm, used to print and compare averages
+
+struct OnlineStatistic{
+	long count;
+	long long total; // Exact sum, so averages are the same as summing every process
+	double mean; // Running mean and sum of squared deviations (Welford's method), for the standard deviation
+	double squaredDeviations;
+	int maximum;
+	long long buckets[HISTOGRAM_BUCKETS]; // Log-bucketed histogram: values below 2 * HISTOGRAM_SUB_BUCKETS are exact, larger values share a bucket with values within 1/16 of them
+}; // struct for a statistic updated once per process, whose memory does not depend on the number of processes
+
+struct LatencyStatistics{
+	struct OnlineStatistic turnaroundTime;
+	struct OnlineStatistic waitingTime;
+	struct OnlineStatistic responseTime; // Time from arrival until the process first runs
+}; // struct for the statistics of one run of an algorithm, updated as each process finishes
+
+struct WindowStep{
+	long completions;
+	long long queueLengthTime; // Sum of queue length over every time unit, so its average is weighted by time
+	int longestQueue;
+	struct OnlineStatistic waitingTime; // Waiting time of the processes that finished during this step
+}; // struct for one step of a SlidingWindow
+
+struct SlidingWindow{
+	struct WindowStep steps[WINDOW_STEPS]; // Circular, steps[currentStep] is being filled
+	int currentStep;
+	int filledSteps; // Steps already closed, up to WINDOW_STEPS
+	int stepLength;
+	long long stepEndTime; // Time when the current step closes and the window is reported, kept wider than an int so it never overflows
+}; // struct for metrics over the last windowLength units of time, which only needs memory for WINDOW_STEPS steps
+
+struct WorkloadGenerator{
+	uint64_t state;
+	enum WorkloadPattern pattern;
+	double arrivalTime;
+	long generatedProcesses;
+}; // struct for a workload generated one process at a time, so that it can go on for as long as needed
+
+struct TuningEntry{
+	int process; // Index of the process in order of arrival
+	int remainingTime;
+}; // struct for one waiting process in the Ready Queue of the autotuner
+
+struct TuningState{
+	struct TuningEntry *ring; // Ready Queue as a circular array, ring[ringHead] is the process to be executed next
+	int ringHead;
+	int ringSize;
+	int ringCapacity;
+	int nextArrival; // Index of the next process to arrive
+	int currentTime;
+	int roundRobin;
+	int lastProcess; // Process that ran last, to count context switches
+	long long slices; // Slices of this schedule since time 0, including the ones shared with other candidates
+	long long totalTurnaroundTime;
+	long long totalWaitingTime;
+	long contextSwitches;
+	struct OnlineStatistic turnaroundTime;
+}; // struct for everything a run of Round Robin changes, which is copied when a group of candidates of the autotuner splits
+
+struct TuningCandidate{
+	int timeQuantum;
+	int totalCompletionTime;
+	double averageTurnaroundTime;
+	double averageWaitingTime;
+	int percentile99TurnaroundTime;
+	long contextSwitches;
+}; // struct for the results of one time quantum tried by the autotuner
+
+struct TuningGroup{
+	int firstEntry; // Candidates of the group are order[firstEntry] to order[lastEntry] inside runAutotune
+	int lastEntry;
+}; // struct for candidates of the autotuner that have had the same schedule so far
+
+struct SweepConfiguration{
+	enum SchedulingAlgorithm algorithm;
+	int timeQuantum;
+	struct SchedulingResult result;
+}; // struct for one algorithm and time quantum to be run by the sweep
+
+struct SweepPool{
+	const struct TraceRecord *workload; // Shared by every worker and never written, so it needs no locking
+	int numberOfProcesses;
+	struct SweepConfiguration *configurations;
+	int numberOfConfigurations;
+	int nextConfiguration; // Index of the next configuration to be taken by a worker
+	pthread_mutex_t mutexToTakeConfiguration;
+}; // struct shared by the workers of the sweep
+
+struct TraceRecord{
+	int32_t processID;
+	int32_t arrivalTime;
+	int32_t burstTime;
+	int32_t priority;
+}; // struct for one process inside a binary trace, which is 16 bytes in native byte order
+
+struct TraceHeader{
+	char magic[4];
+	int32_t version;
+	int32_t recordSize;
+	int32_t reserved;
+}; // struct for the first 16 bytes of a binary trace
+
+struct TraceStream{
+	FILE *file;
+	int isBinary;
+	const struct TraceRecord *mappedRecords; // Records of a memory-mapped binary trace, read in place
+	void *mappedBase;
+	size_t mappedLength;
+	struct TraceRecord *chunk; // Records of a binary trace that is read in chunks
+	long chunkCount;
+	long chunkIndex;
+	long recordCount; // Number of records of a memory-mapped binary trace
+	long nextRecord;
+	struct TraceRecord scratchRecord; // Record parsed from the current line of a text trace
+	long lineNumber;
+	int error;
+}; // struct for reading a trace one record at a time, whether text or binary
+
 struct Process{
 	int processID;
 	int arrivalTime;
@@ -24,81 +291,364 @@ struct Process{
     int turnaroundTime;
     int waitingTime;
     int remainingTime;
+    int tableIndex; // Row of this process inside the ProcessTable of the algorithm currently running
+    int heapIndex; // Slot of this process inside the ReadyHeap, or -1 if it is not in one
+    int firstRunTime; // Time when the process first ran, or -1 if it has not run yet
+    int queueLevel; // Level of the Multilevel Feedback Queue this process is in
+    int levelTimeUsed; // Time this process has run since it joined its level
+    long long virtualRuntime; // Time this process has run in the Completely Fair Scheduler, divided by the weight of its priority
+    long treeSequence; // Insertion order, so that processes with equal virtual runtime keep the order they were inserted in
+    struct Process *treeParent; // Links of the Run Tree, NULL if this process is not in one
+    struct Process *treeLeft;
+    struct Process *treeRight;
+    int treeRed; // 1 if red, 0 if black
     struct Process *nextPtr;
 }; // struct for the Process, containing all relevant variables
 
+struct ProcessTable{
+	int count;
+	struct Process **processes; // Node of each row, used to copy results back for printTable
+	int *arrivalTime; // Arrival time used by the algorithm (without idle time, this may be later than the original arrival time)
+	int *burstTime;
+	int *completionTime;
+	int *turnaroundTime;
+	int *waitingTime;
+	struct LatencyStatistics statistics; // Updated as each process finishes, so totals and percentiles need no pass over the rows
+}; // struct for a columnar (struct of arrays) copy of the processes, so results are computed and summed over contiguous arrays
+
+struct ProcessSlab{
+	struct Process *nodes; // Contiguous block of process nodes
+	int capacity;
+	int used; // Number of nodes already handed out from this block
+	struct ProcessSlab *nextSlab;
+}; // struct for one block of memory inside the ProcessArena
+
+struct ProcessArena{
+	struct ProcessSlab *firstSlab;
+	struct ProcessSlab *currentSlab; // Block where the next node will be taken from
+	struct Process *tailPtr; // Last node appended to the Job Queue, so appending does not need to traverse
+	int processCount;
+}; // struct for allocating processes in large blocks instead of one malloc per process
+
+struct HeapEntry{
+	struct Process *process;
+	int primaryKey; // Value of the sorting metric (arrival time, burst time, priority, process ID or remaining time)
+	int secondaryKey; // Arrival time, used as tie-break so that equal processes still follow FCFS
+	long sequence; // Insertion order, so that fully equal processes keep the order they were inserted in
+}; // struct for one slot of the ReadyHeap
+
+struct ReadyHeap{
+	struct HeapEntry *entries; // Array-based binary min-heap, entries[0] is the process to be executed next
+	int size;
+	int capacity;
+	long nextSequence;
+	enum SortingMetric sortingMetric;
+	void (*insertByMetric)(struct ReadyHeap *heap, struct Process *PtrToTransfer); // Specialized insert of the sorting metric, chosen once in initReadyHeap
+}; // struct for a Ready Queue with O(log n) insertion and removal, ordered the same way as insertToQueue
+
+struct ReadyRing{
+	struct Process **slots; // Circular array, slots[head] is the process to be executed next
+	int head;
+	int size;
+	int capacity; // Always a power of two, so positions wrap with a mask instead of a division
+}; // struct for a first-in first-out Ready Queue where adding to the back, removing from the front and rotating all cost O(1)
+
+struct FeedbackQueues{
+	struct ReadyRing levels[MLFQ_MAXIMUM_LEVELS]; // Level 0 is the highest
+	int timeQuanta[MLFQ_MAXIMUM_LEVELS];
+	int numberOfLevels;
+	uint32_t bitmap; // Bit i is set while level i has processes
+	int size; // Processes in every level
+}; // struct for the Ready Queue of the Multilevel Feedback Queue, where finding and taking the next process both cost O(1)
+
+struct RunTree{
+	struct Process *root;
+	struct Process *leftmost; // Process with the least virtual runtime, kept so that it is found without walking down the tree
+	int size;
+	long long totalWeight; // Sum of the weights of every process in the tree
+	long long minimumVirtualRuntime; // Least virtual runtime seen so far, given to arriving processes
+	long nextSequence;
+}; // struct for the Ready Queue of the Completely Fair Scheduler, a red-black tree where every operation costs O(log n)
+
+struct CpuCore{
+	struct ReadyHeap RunQueue; // Processes placed on (or stolen by) this CPU that are waiting to be executed
+	struct Process *runningProcess; // Kept outside the Run Queue, so that other CPUs can only steal waiting processes
+	struct HeapEntry runningEntry; // Heap entry of the running process, so that it rejoins the Run Queue in the same order if preempted
+	int sliceEndTime; // Time when the running process finishes or its time quantum expires
+	int lastEventTime; // Time up to which the running process has already been charged
+	long long busyTime;
+	long dispatches;
+	long completions;
+	long steals; // Processes this CPU took from the Run Queue of another CPU
+}; // struct for one simulated CPU in multi-core mode
+
 // INPUT FUNCTIONS
 void clearInputBuffer();
-void insertToJobQueue(struct Process **JobQueue, int processNumber, int arrivalTime, int burstTime, enum Priority priority);
-void clearProcesses(struct Process **JobQueue);
+void insertToJobQueue(struct ProcessArena *arena, struct Process **JobQueue, int processNumber, int arrivalTime, int burstTime, enum Priority priority);
+void clearProcesses(struct ProcessArena *arena, struct Process **JobQueue);
+
+// PROCESS ARENA FUNCTIONS
+void initProcessArena(struct ProcessArena *arena);
+struct Process *allocateProcess(struct ProcessArena *arena);
+void freeProcessArena(struct ProcessArena *arena);
 
 // ALGORITHM FUNCTIONS
-void firstComeFirstServe(struct Process **JobQueue, int numberOfProcesses);
-void roundRobinScheduling(struct Process **JobQueue, int numberOfProcesses, int timeQuantum);
-void firstComeFirstServeWithoutIdleTime(struct Process **JobQueue, int numberOfProcesses);
-void roundRobinSchedulingWithoutIdleTime(struct Process **JobQueue, int numberOfProcesses, int timeQuantum);
+struct SchedulingResult firstComeFirstServe(struct Process **JobQueue, int numberOfProcesses);
+struct SchedulingResult roundRobinScheduling(struct Process **JobQueue, int numberOfProcesses, int timeQuantum);
+struct SchedulingResult firstComeFirstServeWithoutIdleTime(struct Process **JobQueue, int numberOfProcesses);
+struct SchedulingResult roundRobinSchedulingWithoutIdleTime(struct Process **JobQueue, int numberOfProcesses, int timeQuantum);
+struct SchedulingResult shortestJobFirst(struct Process **JobQueue, int numberOfProcesses);
+struct SchedulingResult shortestRemainingTimeFirst(struct Process **JobQueue, int numberOfProcesses);
+struct SchedulingResult preemptivePriorityScheduling(struct Process **JobQueue, int numberOfProcesses);
+struct SchedulingResult preemptiveScheduling(struct Process **JobQueue, int numberOfProcesses, enum SortingMetric sortingMetric);
+struct SchedulingResult multilevelFeedbackQueue(struct Process **JobQueue, int numberOfProcesses, int timeQuantum);
+struct SchedulingResult completelyFairScheduling(struct Process **JobQueue, int numberOfProcesses, int timeQuantum);
+struct SchedulingResult runAlgorithm(enum SchedulingAlgorithm algorithm, struct Process **JobQueue, int numberOfProcesses, int timeQuantum);
+void runEveryAlgorithm(struct Process **JobQueue, int numberOfProcesses, int timeQuantum);
 
 // SCHEDULING FUNCTIONS
-void longTermScheduler(struct Process **ReadyQueue, struct Process **JobQueue, int currentTime, enum SortingMetric sortingMetric);
-void longTermSchedulerNoIdleTime(struct Process **JobQueue, struct Process **ReadyQueue, int currentTime, enum SortingMetric sortingMetric);
+void longTermScheduler(struct Process **JobQueue, struct ReadyHeap *ReadyQueue, int currentTime);
+void longTermSchedulerNoIdleTime(struct Process **JobQueue, struct ReadyHeap *ReadyQueue, int currentTime);
+void longTermSchedulerToRing(struct Process **JobQueue, struct ReadyRing *ReadyQueue, int currentTime);
+int roundRobinSliceLength(int remainingTime, int readyProcesses, int currentTime, int nextArrivalTime, int timeQuantum);
+struct Process *takeEarliestArrival(struct Process **JobQueue, int currentTime);
 void insertToQueue(struct Process **ReadyQueue, struct Process *PtrToTransfer, enum SortingMetric sortingMetric);
-void finishProcess(struct Process **ReadyQueue, struct Process **TerminationQueue);
+void linkIntoQueue(struct Process **Queue, struct Process *previousPtr, struct Process *PtrToTransfer);
+void finishProcess(struct ReadyHeap *ReadyQueue, struct ProcessTable *table, int currentTime);
+void terminateProcess(struct Process *PtrToTerminate, struct ProcessTable *table, int currentTime);
 void moveFirstToEnd(struct Process **ReadyQueue);
 void splitQueue(struct Process **JobQueue, struct Process **NewJobQueue, enum Priority priority);
+void sortJobQueueByArrival(struct Process **JobQueue);
+struct Process *mergeByArrival(struct Process *firstList, struct Process *secondList);
+
+// PROCESS TABLE FUNCTIONS
+int initProcessTable(struct ProcessTable *table, struct Process *JobQueue, int numberOfProcesses);
+void freeProcessTable(struct ProcessTable *table);
+void computeProcessMetrics(struct ProcessTable *table);
+void copyMetricsToProcesses(struct ProcessTable *table);
+struct Process *linkProcessesByID(struct ProcessTable *table);
+int compareProcessIDs(const void *first, const void *second);
+
+// READY HEAP FUNCTIONS
+int initReadyHeap(struct ReadyHeap *heap, enum SortingMetric sortingMetric, int initialCapacity);
+void freeReadyHeap(struct ReadyHeap *heap);
+void insertToHeap(struct ReadyHeap *heap, struct Process *PtrToTransfer);
+void insertToHeapWithKey(struct ReadyHeap *heap, struct Process *PtrToTransfer, int primaryKey, int secondaryKey);
+// SORTING METRIC FUNCTIONS, one set per line of SORTING_METRICS
+#define DECLARE_METRIC_FUNCTIONS(metric, primaryKeyOfProcess, secondaryKeyOfProcess) \
+	int primaryKeyBy##metric(const struct Process *process); \
+	int secondaryKeyBy##metric(const struct Process *process); \
+	void insertToHeapBy##metric(struct ReadyHeap *heap, struct Process *PtrToTransfer); \
+	void insertToQueueBy##metric(struct Process **Queue, struct Process *PtrToTransfer);
+SORTING_METRICS(DECLARE_METRIC_FUNCTIONS)
+void insertHeapEntry(struct ReadyHeap *heap, struct HeapEntry entry);
+struct Process *peekHeap(struct ReadyHeap *heap);
+struct Process *popFromHeap(struct ReadyHeap *heap);
+void updateHeapKey(struct ReadyHeap *heap, struct Process *process, int primaryKey);
+int compareHeapEntries(struct HeapEntry *first, struct HeapEntry *second);
+void siftUp(struct ReadyHeap *heap, int index);
+void siftDown(struct ReadyHeap *heap, int index);
+
+// READY RING FUNCTIONS
+int initReadyRing(struct ReadyRing *ring, int initialCapacity);
+void freeReadyRing(struct ReadyRing *ring);
+void pushToRing(struct ReadyRing *ring, struct Process *PtrToTransfer);
+struct Process *peekRing(struct ReadyRing *ring);
+struct Process *popFromRing(struct ReadyRing *ring);
+void rotateRing(struct ReadyRing *ring);
+
+// FEEDBACK QUEUE FUNCTIONS
+int initFeedbackQueues(struct FeedbackQueues *queues, int timeQuantum);
+void freeFeedbackQueues(struct FeedbackQueues *queues);
+void pushToLevel(struct FeedbackQueues *queues, int level, struct Process *PtrToTransfer);
+struct Process *popFromLevel(struct FeedbackQueues *queues, int level);
+int highestReadyLevel(struct FeedbackQueues *queues);
+void boostFeedbackQueues(struct FeedbackQueues *queues);
+void longTermSchedulerToFeedback(struct Process **JobQueue, struct FeedbackQueues *ReadyQueue, int currentTime);
+
+// RUN TREE FUNCTIONS
+int schedulingWeight(int priority);
+void initRunTree(struct RunTree *tree);
+int comparePlacesInTree(struct Process *first, struct Process *second);
+void replaceTreeChild(struct RunTree *tree, struct Process *node, struct Process *child);
+void rotateTreeLeft(struct RunTree *tree, struct Process *node);
+void rotateTreeRight(struct RunTree *tree, struct Process *node);
+void insertToRunTree(struct RunTree *tree, struct Process *PtrToTransfer);
+void removeFromRunTree(struct RunTree *tree, struct Process *PtrToRemove);
+void longTermSchedulerToTree(struct Process **JobQueue, struct RunTree *ReadyQueue, int currentTime);
+
+// TRACE FUNCTIONS
+int openTraceStream(struct TraceStream *stream, const char *path);
+const struct TraceRecord *nextTraceRecord(struct TraceStream *stream);
+const struct TraceRecord *validBinaryRecord(struct TraceStream *stream, const struct TraceRecord *record);
+void closeTraceStream(struct TraceStream *stream);
+int loadTrace(struct ProcessArena *arena, struct Process **JobQueue, const char *path);
+int writeBinaryTrace(struct Process *JobQueue, const char *path);
+int streamScheduling(const char *path, int timeQuantum);
+struct Process *admitTraceRecord(struct ProcessArena *arena, struct Process **FreeList, const struct TraceRecord *record);
+int runTrace(struct ProcessArena *arena);
 
 // INFORMATION FUNCTIONS
 void printTable(struct Process *JobQueue);
 void printAveragesHeader();
-void printAverages(struct Process *JobQueue, int totalCompletionTime, double numberOfProcesses);
+struct SchedulingResult summarizeProcessTable(struct ProcessTable *table, int totalCompletionTime);
+void printAverages(struct SchedulingResult *result);
 
+// STATISTICS FUNCTIONS
+void initOnlineStatistic(struct OnlineStatistic *statistic);
+void addToStatistic(struct OnlineStatistic *statistic, int value);
+void mergeStatistic(struct OnlineStatistic *statistic, struct OnlineStatistic *other);
+int histogramIndex(int value);
+int histogramUpperBound(int index);
+int statisticPercentile(struct OnlineStatistic *statistic, double fraction);
+double statisticStandardDeviation(struct OnlineStatistic *statistic);
+void initLatencyStatistics(struct LatencyStatistics *statistics);
+void recordFirstRun(struct Process *runningProcess, int currentTime);
+void recordLatencies(struct LatencyStatistics *statistics, struct Process *finishedProcess, int currentTime);
+void copyStatisticsToResult(struct LatencyStatistics *statistics, struct SchedulingResult *result);
+void printLatencyStatistics(struct LatencyStatistics *statistics);
+void printStatisticRow(const char *name, struct OnlineStatistic *statistic);
+
+// OUTPUT FUNCTIONS
+int initOutput(void);
+void closeOutput(void);
+void flushOutput(void);
+void writeOutput(const char *format, va_list arguments);
+void appendOutput(const char *text, size_t length);
+void appendInteger(int value);
+void outputText(const char *format, ...);
+void outputSummary(const char *format, ...);
+void outputGanttSlice(int startTime, int endTime, struct Process *runningProcess);
+void outputGanttEnd(void);
+void getProcessLabel(char *label, int processID);
+
+// SWEEP FUNCTIONS
+int loadWorkload(const char *path, struct TraceRecord **workload);
+void buildJobQueue(struct ProcessArena *arena, struct Process **JobQueue, const struct TraceRecord *workload, int numberOfProcesses);
+void *sweepWorker(void *arg);
+int runSweep(void);
+
+// AUTOTUNE FUNCTIONS
+int runAutotune(void);
+double tuningObjectiveValue(struct TuningCandidate *candidate);
+int initTuningState(struct TuningState *state);
+void freeTuningState(struct TuningState *state);
+int copyTuningState(struct TuningState *destination, struct TuningState *source);
+int pushToTuningRing(struct TuningState *state, int process, int remainingTime);
+void popFromTuningRing(struct TuningState *state);
+
+// MULTI-CORE FUNCTIONS
+struct SchedulingResult multiCoreScheduling(enum SchedulingAlgorithm algorithm, struct Process **JobQueue, int numberOfProcesses, int timeQuantum);
+int placeProcess(struct CpuCore *cores, int numberOfCpus, int *nextCpu);
+void dispatchProcess(struct CpuCore *core, struct ReadyHeap *RunQueue, int currentTime, int timeQuantum);
+int stealProcess(struct CpuCore *cores, int numberOfCpus, int thiefIndex, int currentTime, int timeQuantum);
+void printCoreTable(struct CpuCore *cores, int numberOfCpus, int totalCompletionTime);
+
+// BENCHMARK FUNCTIONS
+uint64_t nextRandom(uint64_t *state);
+double randomUniform(uint64_t *state);
+int randomBurstTime(uint64_t *state, enum WorkloadPattern pattern);
+void initWorkloadGenerator(struct WorkloadGenerator *generator, enum WorkloadPattern pattern, uint64_t seed);
+void nextGeneratedRecord(struct WorkloadGenerator *generator, struct TraceRecord *record);
+int generateWorkload(struct TraceRecord **workload, int numberOfProcesses, enum WorkloadPattern pattern, uint64_t seed);
+int writeGeneratedWorkload(void);
+double elapsedSeconds(struct timespec *startTime);
+long peakMemoryKilobytes(void);
+void runBenchmarkRow(enum WorkloadPattern pattern, enum SchedulingAlgorithm algorithm, struct ProcessArena *arena, struct Process **JobQueue,
+	const struct TraceRecord *workload, int numberOfProcesses);
+int runBenchmark(void);
+
+// OPEN SYSTEM FUNCTIONS
+int runOpenSystem(void);
+struct SchedulingResult openSystemScheduling(enum SchedulingAlgorithm algorithm, int timeQuantum);
+const struct TraceRecord *nextArrival(struct TraceStream *stream, struct WorkloadGenerator *generator, struct TraceRecord *generatedRecord);
+void initSlidingWindow(struct SlidingWindow *window, int windowLength);
+void advanceWindow(struct SlidingWindow *window, int startTime, int endTime, int queueLength);
+void recordWindowCompletion(struct SlidingWindow *window, int waitingTime);
+void printWindowHeader(void);
+void printWindow(struct SlidingWindow *window);
 // MISCELLANEOUS FUNCTIONS
 void printLinkedList(struct Process *head);
+int readOptions(int argc, char *argv[]);
+void printUsage(char *programName);
 
-int main(){
+int main(int argc, char *argv[]){
 	struct Process *JobQueue = NULL;
+	struct ProcessArena processArena; // Every process of the test cases is allocated from here
+	
+	if(!readOptions(argc, argv)){ // If an option is invalid, show how to use the program then exit
+		printUsage(argv[0]);
+		return 1;
+	}
+	if(!initOutput()){
+		return 1;
+	}
+	atexit(closeOutput); // Buffered text and the binary Gantt Chart are written out however the program exits
+	initProcessArena(&processArena);
+	
+	if(simulationOptions.benchmarkMaximumProcesses > 0){ // Every algorithm is timed on generated workloads
+		freeProcessArena(&processArena);
+		return runBenchmark();
+	}
+	if(simulationOptions.generatedProcesses > 0){ // A generated workload is written as a binary trace
+		freeProcessArena(&processArena);
+		return writeGeneratedWorkload();
+	}
+	if(simulationOptions.openDuration > 0){ // Processes keep arriving until the duration has passed
+		freeProcessArena(&processArena);
+		return runOpenSystem();
+	}
+	if(simulationOptions.sweepMinimumQuantum > 0){ // Every algorithm and quantum is run in parallel on the trace
+		freeProcessArena(&processArena);
+		return runSweep();
+	}
+	if(simulationOptions.autotuneMinimumQuantum > 0){ // Round Robin is run with every quantum, sharing the common start of their schedules
+		freeProcessArena(&processArena);
+		return runAutotune();
+	}
+	if(simulationOptions.tracePath != NULL){ // Workload comes from a trace instead of the built-in test cases
+		int exitCode = runTrace(&processArena);
+		freeProcessArena(&processArena);
+		return exitCode;
+	}
 	
 	int numberOfProcesses = 7;
 	
-	insertToJobQueue(&JobQueue, 1, 9, 5, HIGH);
-	insertToJobQueue(&JobQueue, 2, 3, 7, MEDIUM);
-	insertToJobQueue(&JobQueue, 3, 40, 4, LOW);
-	insertToJobQueue(&JobQueue, 4, 2, 8, HIGH);
-	insertToJobQueue(&JobQueue, 5, 35, 8, MEDIUM);
-	insertToJobQueue(&JobQueue, 6, 42, 3, LOW);
-	insertToJobQueue(&JobQueue, 7, 4, 10, HIGH);
+	insertToJobQueue(&processArena, &JobQueue, 1, 9, 5, HIGH);
+	insertToJobQueue(&processArena, &JobQueue, 2, 3, 7, MEDIUM);
+	insertToJobQueue(&processArena, &JobQueue, 3, 40, 4, LOW);
+	insertToJobQueue(&processArena, &JobQueue, 4, 2, 8, HIGH);
+	insertToJobQueue(&processArena, &JobQueue, 5, 35, 8, MEDIUM);
+	insertToJobQueue(&processArena, &JobQueue, 6, 42, 3, LOW);
+	insertToJobQueue(&processArena, &JobQueue, 7, 4, 10, HIGH);
 	
-	printf("\nTEST CASE 1: \n");
+	outputSummary("\nTEST CASE 1: \n");
 	
-	firstComeFirstServe(&JobQueue, numberOfProcesses); // Execute FCFS
-	firstComeFirstServeWithoutIdleTime(&JobQueue, numberOfProcesses); // Execute FCFS
-	roundRobinScheduling(&JobQueue, numberOfProcesses, 3);
-	roundRobinSchedulingWithoutIdleTime(&JobQueue, numberOfProcesses, 3);
+	runEveryAlgorithm(&JobQueue, numberOfProcesses, 3);
 	
-	clearProcesses(&JobQueue); 
+	clearProcesses(&processArena, &JobQueue); 
 	
-	insertToJobQueue(&JobQueue, 1, 30, 5, HIGH);
-	insertToJobQueue(&JobQueue, 2, 3, 7, MEDIUM);
-	insertToJobQueue(&JobQueue, 3, 45, 4, LOW);
-	insertToJobQueue(&JobQueue, 4, 2, 8, HIGH);
-	insertToJobQueue(&JobQueue, 5, 35, 8, MEDIUM);
-	insertToJobQueue(&JobQueue, 6, 47, 3, LOW);
-	insertToJobQueue(&JobQueue, 7, 4, 10, HIGH);	
+	insertToJobQueue(&processArena, &JobQueue, 1, 30, 5, HIGH);
+	insertToJobQueue(&processArena, &JobQueue, 2, 3, 7, MEDIUM);
+	insertToJobQueue(&processArena, &JobQueue, 3, 45, 4, LOW);
+	insertToJobQueue(&processArena, &JobQueue, 4, 2, 8, HIGH);
+	insertToJobQueue(&processArena, &JobQueue, 5, 35, 8, MEDIUM);
+	insertToJobQueue(&processArena, &JobQueue, 6, 47, 3, LOW);
+	insertToJobQueue(&processArena, &JobQueue, 7, 4, 10, HIGH);	
 	
-	printf("\n\nTEST CASE 2: \n");
+	outputSummary("\n\nTEST CASE 2: \n");
 	
-	firstComeFirstServe(&JobQueue, numberOfProcesses); // Execute FCFS
-	firstComeFirstServeWithoutIdleTime(&JobQueue, numberOfProcesses); // Execute FCFS
-	roundRobinScheduling(&JobQueue, numberOfProcesses, 3);
-	roundRobinSchedulingWithoutIdleTime(&JobQueue, numberOfProcesses, 3);
+	runEveryAlgorithm(&JobQueue, numberOfProcesses, 3);
 	
 	
-	clearProcesses(&JobQueue); 
+	clearProcesses(&processArena, &JobQueue); 
+	freeProcessArena(&processArena);
 	
 	return 0;
 }
 
-void insertToJobQueue(struct Process **JobQueue, int processNumber, int arrivalTime, int burstTime, enum Priority priority){
-    struct Process *newPtr = malloc(sizeof(struct Process)); // First we dynamically allocate a memory of size struct Process
+void insertToJobQueue(struct ProcessArena *arena, struct Process **JobQueue, int processNumber, int arrivalTime, int burstTime, enum Priority priority){
+    struct Process *newPtr = allocateProcess(arena); // First we take a node of size struct Process from the arena
     
     if(newPtr != NULL){ // We check if this memory was successfully allocated 
         newPtr->processID = processNumber; // Then we input all the relevant information into the node
@@ -110,333 +660,793 @@ void insertToJobQueue(struct Process **JobQueue, int processNumber, int arrivalT
         newPtr->turnaroundTime = 0;
         newPtr->waitingTime = 0;
         newPtr->remainingTime = burstTime; // Remaining time defaults to burst time as it is full
+        newPtr->tableIndex = 0; // Row is given once an algorithm creates its Process Table
+        newPtr->heapIndex = -1;
+        newPtr->firstRunTime = -1;
+        newPtr->queueLevel = 0;
+        newPtr->levelTimeUsed = 0;
+        newPtr->virtualRuntime = 0;
+        newPtr->treeSequence = 0;
+        newPtr->treeParent = NULL;
+        newPtr->treeLeft = NULL;
+        newPtr->treeRight = NULL;
+        newPtr->treeRed = 0;
         newPtr->nextPtr = NULL;
-        struct Process *previousPtr = NULL;
-        struct Process *currentPtr = *JobQueue;
-
-        while(currentPtr != NULL){ // Then we traverse to the end of JobQueue for insertion
-            previousPtr = currentPtr;
-            currentPtr = currentPtr->nextPtr;
-        }
-        if(previousPtr == NULL){ // This means we are at the beginning, or we did not traverse
-            newPtr->nextPtr = *JobQueue; // Hence, newPtr will point at previous first Node or NULL
+        
+        if(*JobQueue == NULL){ // This means the Job Queue is empty
             *JobQueue = newPtr; // Then newPtr is now the headPointer or first Node
         }
-        else{ // Otherwise, we insert the new node in between the previousPtr and currentPtr
-            previousPtr->nextPtr = newPtr; // previousPtr now points to newPtr
-            newPtr->nextPtr = currentPtr; // newPtr now points to currentPtr
+        else{ // Otherwise, we append the new node after the tail
+            struct Process *tailPtr = arena->tailPtr;
+            while(tailPtr->nextPtr != NULL){ // Only traverses if an algorithm reordered the Job Queue since the last append
+                tailPtr = tailPtr->nextPtr;
+            }
+            tailPtr->nextPtr = newPtr; // Last node now points to newPtr
         }
+        arena->tailPtr = newPtr; // newPtr is now the last node
     }
     else{ // If ever memory allocation fails, we notify.
         printf("Process %d is not inserted as there is no more memory.\n", processNumber);
     }
 }
 
-void clearProcesses(struct Process **JobQueue) { // This works like a deQueue or removing first node, and done again and again until list is empty
-    while (*JobQueue != NULL) {  // Loop until all nodes are deleted
-        struct Process *tempPtr = *JobQueue;  // Temporarily store the current node
-        *JobQueue = (*JobQueue)->nextPtr;  // Move head pointer to the next node
-        free(tempPtr);  // Free the former head node
+void clearProcesses(struct ProcessArena *arena, struct Process **JobQueue) { // Since every process comes from the arena, we release them all at once
+    struct ProcessSlab *currentSlab = arena->firstSlab;
+    while (currentSlab != NULL) {  // Blocks are kept so that the next test case can reuse them
+        currentSlab->used = 0;
+        currentSlab = currentSlab->nextSlab;
     }
+    arena->currentSlab = arena->firstSlab;
+    arena->tailPtr = NULL;
+    arena->processCount = 0;
+    *JobQueue = NULL;  // Job Queue now references nothing
 }
 
-void firstComeFirstServe(struct Process **JobQueue, int numberOfProcesses){
-	printf("\n\nProceeding to First Come First Serve Algorithm with Idle Times...\n\n"); 
+struct SchedulingResult firstComeFirstServe(struct Process **JobQueue, int numberOfProcesses){
+	outputSummary("\n\nProceeding to First Come First Serve Algorithm with Idle Times...\n\n"); 
 	// If schedulingMode is individual, algorithm will print this along with Gantt Chart, Table of Processes, and other headers and information
 	enum SortingMetric sortingMetric = LEASTARRIVALTIME;
 	// First Come First Serve executes processes with lowest arrival time first
-	struct Process *ReadyQueue = NULL; // We create a local Ready Queue and Termination Queue to be used within the algorithm
-    struct Process *TerminationQueue = NULL;
+	struct ReadyHeap ReadyQueue; // Local Ready Queue, a binary heap, while finished processes are recorded in the Process Table
+    struct Process *runningProcess = NULL; // Process at the front of the Ready Queue, which is the one being executed
+    struct ProcessTable table; // Results are written into the table by index
+    struct SchedulingResult result = {0, 0, 0, 0, 0, 0}; // Totals returned to the caller, so runs can be compared
+    if(!initReadyHeap(&ReadyQueue, sortingMetric, numberOfProcesses) // Ready Queue is a binary heap ordered by the sorting metric
+    || !initProcessTable(&table, *JobQueue, numberOfProcesses)){ // Without the Ready Queue or the table the algorithm cannot run, so it stops
+    	freeReadyHeap(&ReadyQueue);
+    	return result;
+    }
     
-    printf("Gantt chart: \n");
+    outputText("Gantt chart: \n");
     int currentTime = 0; // Current time starts at zero
+    int sliceStartTime = 0;
+    sortJobQueueByArrival(JobQueue); // Sort once, so that processes are admitted from the front of the Job Queue
     
-    while(*JobQueue != NULL || ReadyQueue != NULL){ // We will keep executing the algorithm until all processes have arrived AND been executed
-        longTermScheduler(JobQueue, &ReadyQueue, currentTime, sortingMetric); // This lets processes arrive at current time
-    	printf("[%d", currentTime);	// Print starting time of process in Gantt Chart
-		if(ReadyQueue!=NULL){ // If there are processes that have arrived, or already arrived but not executed within the ReadyQueue
-			printf(" %c ", ReadyQueue->processID+64); // Print PID of current process in Gantt Chart
-			currentTime += ReadyQueue->burstTime; // Add current time with burst time
-            ReadyQueue->completionTime = currentTime; // Completion time will be calculated
-            ReadyQueue->turnaroundTime = ReadyQueue->completionTime - ReadyQueue->arrivalTime; // TAT = CT - AT
-            ReadyQueue->waitingTime = ReadyQueue->turnaroundTime - ReadyQueue->burstTime; // WT = TAT - BT
-            finishProcess(&ReadyQueue, &TerminationQueue); // Then transfer currently executed process to TerminationQueue
+    long long numberOfEvents = 0;
+    while(*JobQueue != NULL || ReadyQueue.size > 0){ // We will keep executing the algorithm until all processes have arrived AND been executed
+    	numberOfEvents++; // Every pass of the loop is one event, which the benchmark counts
+        longTermScheduler(JobQueue, &ReadyQueue, currentTime); // This lets processes arrive at current time
+    	sliceStartTime = currentTime; // Remember starting time of process for Gantt Chart
+		if(ReadyQueue.size > 0){ // If there are processes that have arrived, or already arrived but not executed within the ReadyQueue
+			runningProcess = peekHeap(&ReadyQueue);
+			recordFirstRun(runningProcess, currentTime);
+			currentTime += runningProcess->burstTime; // Add current time with burst time
+            finishProcess(&ReadyQueue, &table, currentTime); // Then record completion time of currently executed process in the Process Table
         }
         else{
-            currentTime += 1; // If there are no arrived processes, we let the time increase by 1 (IDLE)
-        	printf(" __ "); // Print an idle box for Gantt Chart
+            if(simulationOptions.clockMode == EVENTCLOCK){ // If there are no arrived processes, we jump straight to the next arrival (IDLE)
+            	currentTime = (*JobQueue)->arrivalTime; // Job Queue is sorted, so its first process is the next arrival
+			}
+			else{
+            	currentTime += 1; // If there are no arrived processes, we let the time increase by 1 (IDLE)
+			}
+        	runningProcess = NULL; // No process, so Gantt Chart shows an idle box
         }
-        printf("%d]", currentTime);	// Print ending time of current process in Gantt Chart
+        outputGanttSlice(sliceStartTime, currentTime, runningProcess); // Print the box of current process in Gantt Chart
     }
-    *JobQueue = TerminationQueue; // Once all processes are in Termination Queue (which is ordered by PID), we let JobQueue reference it
-    TerminationQueue = NULL; // Then TerminationQueue will now reference null
+    outputGanttEnd(); // Gantt Chart of this algorithm is complete
+    freeReadyHeap(&ReadyQueue);
+    *JobQueue = linkProcessesByID(&table); // Once all processes are finished, we let JobQueue reference them ordered by PID
+    computeProcessMetrics(&table); // Compute TAT and WT of every process at once
+    copyMetricsToProcesses(&table);
 	printTable(*JobQueue); // Only print Table and Averages Header if Individual
 	printAveragesHeader();
-	printAverages(*JobQueue, currentTime, numberOfProcesses); // Then print Total Completion Time, Avg TAT, Avg CT, and Throughput
+	result = summarizeProcessTable(&table, currentTime);
+	result.numberOfEvents = numberOfEvents;
+	printAverages(&result); // Then print Total Completion Time, Avg TAT, Avg CT, and Throughput
+	printLatencyStatistics(&table.statistics);
+	freeProcessTable(&table);
+	return result;
 }
 
-void firstComeFirstServeWithoutIdleTime(struct Process **JobQueue, int numberOfProcesses){
-	printf("\n\nProceeding to First Come First Serve Algorithm without Idle Times...\n\n"); 
+struct SchedulingResult firstComeFirstServeWithoutIdleTime(struct Process **JobQueue, int numberOfProcesses){
+	outputSummary("\n\nProceeding to First Come First Serve Algorithm without Idle Times...\n\n"); 
 	 // If schedulingMode is individual, algorithm will print this along with Gantt Chart, Table of Processes, and other headers and information
 	enum SortingMetric sortingMetric = LEASTARRIVALTIME;
 	// First Come First Serve executes processes with lowest arrival time first
-	struct Process *ReadyQueue = NULL; // We create a local Ready Queue and Termination Queue to be used within the algorithm
-    struct Process *TerminationQueue = NULL;
+	struct ReadyHeap ReadyQueue; // Local Ready Queue, a binary heap, while finished processes are recorded in the Process Table
+    struct Process *runningProcess = NULL; // Process at the front of the Ready Queue, which is the one being executed
+    struct ProcessTable table; // Results are written into the table by index
+    struct SchedulingResult result = {0, 0, 0, 0, 0, 0}; // Totals returned to the caller, so runs can be compared
+    if(!initReadyHeap(&ReadyQueue, sortingMetric, numberOfProcesses) // Ready Queue is a binary heap ordered by the sorting metric
+    || !initProcessTable(&table, *JobQueue, numberOfProcesses)){ // Without the Ready Queue or the table the algorithm cannot run, so it stops
+    	freeReadyHeap(&ReadyQueue);
+    	return result;
+    }
     
-    printf("Gantt chart: \n");
+    outputText("Gantt chart: \n");
 	
     int currentTime = 0; // Current time starts at zero
+    int sliceStartTime = 0;
+    sortJobQueueByArrival(JobQueue); // Sort once, so that processes are admitted from the front of the Job Queue
     
-    while(*JobQueue != NULL || ReadyQueue != NULL){ // We will keep executing the algorithm until all processes have arrived AND been executed
-		longTermScheduler(JobQueue, &ReadyQueue, currentTime, sortingMetric); // This lets processes arrive at current time
-        printf("[%d", currentTime);	// Print starting time of process in Gantt Chart
-	
-		if(ReadyQueue!=NULL){ // If there are processes that have arrived, or already arrived but not executed within the ReadyQueue
-			printf(" %c ", ReadyQueue->processID+64); // Print PID of current process in Gantt Chart
-			currentTime += ReadyQueue->burstTime; // Add current time with burst time
-            ReadyQueue->completionTime = currentTime; // Completion time will be calculated
-            ReadyQueue->turnaroundTime = ReadyQueue->completionTime - ReadyQueue->arrivalTime; // TAT = CT - AT
-            ReadyQueue->waitingTime = ReadyQueue->turnaroundTime - ReadyQueue->burstTime; // WT = TAT - BT
-            finishProcess(&ReadyQueue, &TerminationQueue); // Then transfer currently executed process to TerminationQueue
+    long long numberOfEvents = 0;
+    while(*JobQueue != NULL || ReadyQueue.size > 0){ // We will keep executing the algorithm until all processes have arrived AND been executed
+    	numberOfEvents++;
+		longTermScheduler(JobQueue, &ReadyQueue, currentTime); // This lets processes arrive at current time
+        sliceStartTime = currentTime; // Remember starting time of process for Gantt Chart
+	
+		if(ReadyQueue.size > 0){ // If there are processes that have arrived, or already arrived but not executed within the ReadyQueue
+			runningProcess = peekHeap(&ReadyQueue);
+			recordFirstRun(runningProcess, currentTime);
+			currentTime += runningProcess->burstTime; // Add current time with burst time
+            finishProcess(&ReadyQueue, &table, currentTime); // Then record completion time of currently executed process in the Process Table
         }
         else{
-            longTermSchedulerNoIdleTime(JobQueue, &ReadyQueue, currentTime, sortingMetric);
-			printf(" %c ", ReadyQueue->processID+64); // Print PID of current process in Gantt Chart
-			ReadyQueue->arrivalTime = currentTime;
-			//printf("ARRIVAL TIME: %d", ReadyQueue->arrivalTime);
-			currentTime += ReadyQueue->burstTime; // Add current time with burst time
-            ReadyQueue->completionTime = currentTime; // Completion time will be calculated
-            ReadyQueue->turnaroundTime = ReadyQueue->completionTime - ReadyQueue->arrivalTime; // TAT = CT - AT
-            ReadyQueue->waitingTime = ReadyQueue->turnaroundTime - ReadyQueue->burstTime; // WT = TAT - BT
-            finishProcess(&ReadyQueue, &TerminationQueue); // Then transfer currently executed process to TerminationQueue
+            longTermSchedulerNoIdleTime(JobQueue, &ReadyQueue, currentTime); // This also sets arrival time of the process to currentTime
+			runningProcess = peekHeap(&ReadyQueue);
+			recordFirstRun(runningProcess, currentTime);
+			//printf("ARRIVAL TIME: %d", runningProcess->arrivalTime);
+			currentTime += runningProcess->burstTime; // Add current time with burst time
+            finishProcess(&ReadyQueue, &table, currentTime); // Then record completion time of currently executed process in the Process Table
 //            printf("Printing Job Queue: ");
 //			printLinkedList(*JobQueue);
 //			printf("\n");
 			}
-        printf("%d]", currentTime);	// Print ending time of current process in Gantt Chart
+        outputGanttSlice(sliceStartTime, currentTime, runningProcess); // Print the box of current process in Gantt Chart
 		
     }
-    *JobQueue = TerminationQueue; // Once all processes are in Termination Queue (which is ordered by PID), we let JobQueue reference it
-    TerminationQueue = NULL; // Then TerminationQueue will now reference null
+    outputGanttEnd(); // Gantt Chart of this algorithm is complete
+    freeReadyHeap(&ReadyQueue);
+    *JobQueue = linkProcessesByID(&table); // Once all processes are finished, we let JobQueue reference them ordered by PID
+    computeProcessMetrics(&table); // Compute TAT and WT of every process at once
+    copyMetricsToProcesses(&table);
 	printTable(*JobQueue); // Only print Table and Averages Header if Individual
 	printAveragesHeader();
 
-	printAverages(*JobQueue, currentTime, numberOfProcesses); // Then print Total Completion Time, Avg TAT, Avg CT, and Throughput
+	result = summarizeProcessTable(&table, currentTime);
+	result.numberOfEvents = numberOfEvents;
+	printAverages(&result); // Then print Total Completion Time, Avg TAT, Avg CT, and Throughput
+	printLatencyStatistics(&table.statistics);
+	freeProcessTable(&table);
+	return result;
 }
 
-void roundRobinScheduling(struct Process **JobQueue, int numberOfProcesses, int timeQuantum){
-	printf("\n\nProceeding to Round Robin Scheduling with Idle Times...\n\n");
-	enum SortingMetric sortingMetric = LEASTARRIVALTIME; // Round Robin follows a FCFS sorting within the Ready Queue, but it is preemptive wherein it only processes a specific time quantum
-	
-	struct Process *ReadyQueue = NULL;
-    struct Process *TerminationQueue = NULL;
+struct SchedulingResult roundRobinScheduling(struct Process **JobQueue, int numberOfProcesses, int timeQuantum){
+	outputSummary("\n\nProceeding to Round Robin Scheduling with Idle Times...\n\n");
+	// Round Robin follows a FCFS order within the Ready Queue, but it is preemptive wherein it only processes a specific time quantum
+	// Since processes join the back of the Ready Queue in order of arrival (or of preemption), a ring is enough and rotating costs O(1)
+	struct ReadyRing ReadyQueue;
+    struct Process *runningProcess = NULL;
+    struct ProcessTable table;
+    struct SchedulingResult result = {0, 0, 0, 0, 0, 0};
+    if(!initReadyRing(&ReadyQueue, numberOfProcesses)
+    || !initProcessTable(&table, *JobQueue, numberOfProcesses)){ // Without the Ready Queue or the table the algorithm cannot run, so it stops
+    	freeReadyRing(&ReadyQueue);
+    	return result;
+    }
     
     int currentTime = 0;
+    int sliceStartTime = 0;
+    sortJobQueueByArrival(JobQueue);
     int roundRobin = 0; // We have a variable to note if a process should be placed to the end of the queue
     
-    while(*JobQueue != NULL || ReadyQueue != NULL) {
-        longTermScheduler(JobQueue, &ReadyQueue, currentTime, sortingMetric); // Note that we let new processes ARRIVE FIRST before doing a round robin
+    long long numberOfEvents = 0;
+    while(*JobQueue != NULL || ReadyQueue.size > 0) {
+    	numberOfEvents++;
+        longTermSchedulerToRing(JobQueue, &ReadyQueue, currentTime); // Note that we let new processes ARRIVE FIRST before doing a round robin
         if(roundRobin == 1) { // If round robin is 1, we will move the first process to the end
-            moveFirstToEnd(&ReadyQueue);
+            rotateRing(&ReadyQueue);
         }
-		printf("[%d", currentTime); 
-        if(ReadyQueue != NULL) {
-			printf(" %c ", ReadyQueue->processID+64);
-            if(ReadyQueue->remainingTime <= timeQuantum) { // If current process will be finished with one time quantum
-                currentTime += ReadyQueue->remainingTime; // We add current time with remaining time (since sometimes, processes' remaining time is less than time quantum, so full time quantum is not consumed)
-                ReadyQueue->remainingTime = 0; // Remaining time is now zero, since process is finished
-                ReadyQueue->completionTime = currentTime; // Set CT to currentTime of finishing
-                ReadyQueue->turnaroundTime = ReadyQueue->completionTime - ReadyQueue->arrivalTime;
-                ReadyQueue->waitingTime = ReadyQueue->turnaroundTime - ReadyQueue->burstTime;
-                finishProcess(&ReadyQueue, &TerminationQueue);
+		sliceStartTime = currentTime;
+        if(ReadyQueue.size > 0) {
+			runningProcess = peekRing(&ReadyQueue);
+			recordFirstRun(runningProcess, currentTime);
+			int sliceLength = roundRobinSliceLength(runningProcess->remainingTime, ReadyQueue.size, currentTime, // One quantum, or several merged if the process is alone
+				(*JobQueue != NULL) ? (*JobQueue)->arrivalTime : -1, timeQuantum);
+            if(runningProcess->remainingTime <= sliceLength) { // If current process will be finished within the slice
+                currentTime += runningProcess->remainingTime; // We add current time with remaining time (since sometimes, processes' remaining time is less than time quantum, so full time quantum is not consumed)
+                runningProcess->remainingTime = 0; // Remaining time is now zero, since process is finished
+                terminateProcess(popFromRing(&ReadyQueue), &table, currentTime); // Record CT, since TAT and WT are computed once the algorithm ends
                 roundRobin = 0; // Set roundRobin to zero, since we instead moved process to termination queue, so no round robin
             }
-            else { // Else if process is not finishable by one time quantum
-                currentTime += timeQuantum; // Move time forward by one time quantum
-                ReadyQueue->remainingTime -= timeQuantum; // Remove one time quantum from remaining time
+            else { // Else if process is not finishable within the slice
+                currentTime += sliceLength; // Move time forward by the slice, which is a whole number of time quantums
+                runningProcess->remainingTime -= sliceLength; // Remove the slice from remaining time
                 roundRobin = 1; // Then set round robin to 1, so that after new processes arrive at new time, we move current process to back
             }
         }
         else {
-            currentTime += 1;
-            printf(" __ ");
+            if(simulationOptions.clockMode == EVENTCLOCK){ // Jump to next arrival, same as First Come First Serve
+            	currentTime = (*JobQueue)->arrivalTime;
+			}
+			else{
+            	currentTime += 1;
+			}
+            runningProcess = NULL;
         }
-        printf("%d]", currentTime);
+        outputGanttSlice(sliceStartTime, currentTime, runningProcess);
     }
-    *JobQueue = TerminationQueue;
-    TerminationQueue = NULL;
+    outputGanttEnd(); // Gantt Chart of this algorithm is complete
+    freeReadyRing(&ReadyQueue);
+    *JobQueue = linkProcessesByID(&table);
+    computeProcessMetrics(&table);
+    copyMetricsToProcesses(&table);
 	printTable(*JobQueue);
 	printAveragesHeader();
-	printAverages(*JobQueue, currentTime, numberOfProcesses); 
+	result = summarizeProcessTable(&table, currentTime);
+	result.numberOfEvents = numberOfEvents;
+	printAverages(&result); 
+	printLatencyStatistics(&table.statistics);
+	freeProcessTable(&table);
+	return result;
 }
 
-void roundRobinSchedulingWithoutIdleTime(struct Process **JobQueue, int numberOfProcesses, int timeQuantum){
-	printf("\n\nProceeding to Round Robin Scheduling without Idle Times...\n\n");
-	enum SortingMetric sortingMetric = LEASTARRIVALTIME; // Round Robin follows a FCFS sorting within the Ready Queue, but it is preemptive wherein it only processes a specific time quantum
-	
-	struct Process *ReadyQueue = NULL;
-    struct Process *TerminationQueue = NULL;
+struct SchedulingResult roundRobinSchedulingWithoutIdleTime(struct Process **JobQueue, int numberOfProcesses, int timeQuantum){
+	outputSummary("\n\nProceeding to Round Robin Scheduling without Idle Times...\n\n");
+	// Round Robin follows a FCFS order within the Ready Queue, but it is preemptive wherein it only processes a specific time quantum
+	// Since processes join the back of the Ready Queue in order of arrival (or of preemption), a ring is enough and rotating costs O(1)
+	struct ReadyRing ReadyQueue;
+    struct Process *runningProcess = NULL;
+    struct ProcessTable table;
+    struct SchedulingResult result = {0, 0, 0, 0, 0, 0};
+    if(!initReadyRing(&ReadyQueue, numberOfProcesses)
+    || !initProcessTable(&table, *JobQueue, numberOfProcesses)){ // Without the Ready Queue or the table the algorithm cannot run, so it stops
+    	freeReadyRing(&ReadyQueue);
+    	return result;
+    }
     
     int currentTime = 0;
+    int sliceStartTime = 0;
+    sortJobQueueByArrival(JobQueue);
     int roundRobin = 0; // We have a variable to note if a process should be placed to the end of the queue
     
-    while(*JobQueue != NULL || ReadyQueue != NULL) {
-        longTermScheduler(JobQueue, &ReadyQueue, currentTime, sortingMetric); // Note that we let new processes ARRIVE FIRST before doing a round robin
-        if(ReadyQueue == NULL){
-        	longTermSchedulerNoIdleTime(JobQueue, &ReadyQueue, currentTime, sortingMetric);
-        	ReadyQueue->arrivalTime = currentTime;
+    long long numberOfEvents = 0;
+    while(*JobQueue != NULL || ReadyQueue.size > 0) {
+    	numberOfEvents++;
+        longTermSchedulerToRing(JobQueue, &ReadyQueue, currentTime); // Note that we let new processes ARRIVE FIRST before doing a round robin
+        if(ReadyQueue.size == 0){
+        	pushToRing(&ReadyQueue, takeEarliestArrival(JobQueue, currentTime)); // This also sets arrival time of the process to currentTime
 		}
 		if(roundRobin == 1) { // If round robin is 1, we will move the first process to the end
-            moveFirstToEnd(&ReadyQueue);
+            rotateRing(&ReadyQueue);
         }
-		printf("[%d", currentTime); 
-        if(ReadyQueue != NULL) {
-			printf(" %c ", ReadyQueue->processID+64);
-            if(ReadyQueue->remainingTime <= timeQuantum) { // If current process will be finished with one time quantum
-                currentTime += ReadyQueue->remainingTime; // We add current time with remaining time (since sometimes, processes' remaining time is less than time quantum, so full time quantum is not consumed)
-                ReadyQueue->remainingTime = 0; // Remaining time is now zero, since process is finished
-                ReadyQueue->completionTime = currentTime; // Set CT to currentTime of finishing
-                ReadyQueue->turnaroundTime = ReadyQueue->completionTime - ReadyQueue->arrivalTime;
-                ReadyQueue->waitingTime = ReadyQueue->turnaroundTime - ReadyQueue->burstTime;
-                finishProcess(&ReadyQueue, &TerminationQueue);
+		sliceStartTime = currentTime;
+        if(ReadyQueue.size > 0) {
+			runningProcess = peekRing(&ReadyQueue);
+			recordFirstRun(runningProcess, currentTime);
+			int sliceLength = roundRobinSliceLength(runningProcess->remainingTime, ReadyQueue.size, currentTime, // One quantum, or several merged if the process is alone
+				(*JobQueue != NULL) ? (*JobQueue)->arrivalTime : -1, timeQuantum);
+            if(runningProcess->remainingTime <= sliceLength) { // If current process will be finished within the slice
+                currentTime += runningProcess->remainingTime; // We add current time with remaining time (since sometimes, processes' remaining time is less than time quantum, so full time quantum is not consumed)
+                runningProcess->remainingTime = 0; // Remaining time is now zero, since process is finished
+                terminateProcess(popFromRing(&ReadyQueue), &table, currentTime); // Record CT, since TAT and WT are computed once the algorithm ends
                 roundRobin = 0; // Set roundRobin to zero, since we instead moved process to termination queue, so no round robin
             }
-            else { // Else if process is not finishable by one time quantum
-                currentTime += timeQuantum; // Move time forward by one time quantum
-                ReadyQueue->remainingTime -= timeQuantum; // Remove one time quantum from remaining time
+            else { // Else if process is not finishable within the slice
+                currentTime += sliceLength; // Move time forward by the slice, which is a whole number of time quantums
+                runningProcess->remainingTime -= sliceLength; // Remove the slice from remaining time
                 roundRobin = 1; // Then set round robin to 1, so that after new processes arrive at new time, we move current process to back
             }
         }
-        printf("%d]", currentTime);
+        outputGanttSlice(sliceStartTime, currentTime, runningProcess);
+    }
+    outputGanttEnd(); // Gantt Chart of this algorithm is complete
+    freeReadyRing(&ReadyQueue);
+    *JobQueue = linkProcessesByID(&table);
+    computeProcessMetrics(&table);
+    copyMetricsToProcesses(&table);
+	printTable(*JobQueue);
+	printAveragesHeader();
+	result = summarizeProcessTable(&table, currentTime);
+	result.numberOfEvents = numberOfEvents;
+	printAverages(&result); 
+	printLatencyStatistics(&table.statistics);
+	freeProcessTable(&table);
+	return result;
+}
+
+struct SchedulingResult shortestJobFirst(struct Process **JobQueue, int numberOfProcesses){
+	outputSummary("\n\nProceeding to Shortest Job First Scheduling...\n\n");
+	enum SortingMetric sortingMetric = LEASTBURSTTIME; // Shortest Job First executes processes with lowest burst time first, but it is not preemptive
+	
+	struct ReadyHeap ReadyQueue;
+    struct Process *runningProcess = NULL;
+    struct ProcessTable table;
+    struct SchedulingResult result = {0, 0, 0, 0, 0, 0};
+    if(!initReadyHeap(&ReadyQueue, sortingMetric, numberOfProcesses)
+    || !initProcessTable(&table, *JobQueue, numberOfProcesses)){ // Without the Ready Queue or the table the algorithm cannot run, so it stops
+    	freeReadyHeap(&ReadyQueue);
+    	return result;
+    }
+    
+    outputText("Gantt chart: \n");
+    int currentTime = 0;
+    int sliceStartTime = 0;
+    sortJobQueueByArrival(JobQueue);
+    
+    long long numberOfEvents = 0;
+    while(*JobQueue != NULL || ReadyQueue.size > 0){
+    	numberOfEvents++;
+        longTermScheduler(JobQueue, &ReadyQueue, currentTime);
+    	sliceStartTime = currentTime;
+		if(ReadyQueue.size > 0){ // Shortest arrived process runs until it is finished, even if a shorter one arrives meanwhile
+			runningProcess = peekHeap(&ReadyQueue);
+			recordFirstRun(runningProcess, currentTime);
+			currentTime += runningProcess->burstTime;
+            finishProcess(&ReadyQueue, &table, currentTime);
+        }
+        else{
+            currentTime = (*JobQueue)->arrivalTime; // Nothing to execute, so jump straight to the next arrival (IDLE)
+        	runningProcess = NULL;
+        }
+        outputGanttSlice(sliceStartTime, currentTime, runningProcess);
     }
-    *JobQueue = TerminationQueue;
-    TerminationQueue = NULL;
+    outputGanttEnd(); // Gantt Chart of this algorithm is complete
+    freeReadyHeap(&ReadyQueue);
+    *JobQueue = linkProcessesByID(&table);
+    computeProcessMetrics(&table);
+    copyMetricsToProcesses(&table);
 	printTable(*JobQueue);
 	printAveragesHeader();
-	printAverages(*JobQueue, currentTime, numberOfProcesses); 
+	result = summarizeProcessTable(&table, currentTime);
+	result.numberOfEvents = numberOfEvents;
+	printAverages(&result); 
+	printLatencyStatistics(&table.statistics);
+	freeProcessTable(&table);
+	return result;
+}
+
+struct SchedulingResult shortestRemainingTimeFirst(struct Process **JobQueue, int numberOfProcesses){
+	outputSummary("\n\nProceeding to Shortest Remaining Time First Scheduling...\n\n");
+	return preemptiveScheduling(JobQueue, numberOfProcesses, LEASTREMAININGTIME); // An arrival with less remaining time than the running process preempts it
 }
 
+struct SchedulingResult preemptivePriorityScheduling(struct Process **JobQueue, int numberOfProcesses){
+	outputSummary("\n\nProceeding to Preemptive Priority Scheduling...\n\n");
+	return preemptiveScheduling(JobQueue, numberOfProcesses, HIGHESTPRIORITY); // An arrival with higher priority than the running process preempts it
+}
 
-// longTermScheduler checks for processes that should HAVE ARRIVED given currentTime and inserts them to Ready Queue based on a sorting Metric 
-void longTermSchedulerNoIdleTime(struct Process **JobQueue, struct Process **ReadyQueue, int currentTime, enum SortingMetric sortingMetric){
-    struct Process *currentPtr = (*JobQueue)->nextPtr; // Assign first node of JobQueue to currentPtr
-    struct Process *PtrToTransfer = *JobQueue; // create a PtrToTransfer, which holds process to transfer to ready queue
-    struct Process *prevPtr = NULL;
+// This function runs a preemptive algorithm where the first process of the Ready Queue is always the one being executed
+// Instead of moving time by 1, the running process executes until it finishes or until the next arrival, whichever comes first
+// Only an arrival can preempt, so there are at most 2n steps, and each one costs O(log n) on the Ready Heap
+// A box is added to the Gantt Chart only when the running process finishes or is preempted
+struct SchedulingResult preemptiveScheduling(struct Process **JobQueue, int numberOfProcesses, enum SortingMetric sortingMetric){
+	struct ReadyHeap ReadyQueue;
+    struct Process *runningProcess = NULL;
+    struct Process *dispatchedProcess = NULL; // Process that started the current box of the Gantt Chart
+    struct ProcessTable table;
+    struct SchedulingResult result = {0, 0, 0, 0, 0, 0};
+    if(!initReadyHeap(&ReadyQueue, sortingMetric, numberOfProcesses)
+    || !initProcessTable(&table, *JobQueue, numberOfProcesses)){ // Without the Ready Queue or the table the algorithm cannot run, so it stops
+    	freeReadyHeap(&ReadyQueue);
+    	return result;
+    }
     
-    while(currentPtr != NULL){ // Loop through entire Job Queue
-        if(currentPtr->arrivalTime <= PtrToTransfer->arrivalTime){ // Check if process should have arrived (lesser than or equal to currentTime)
-            PtrToTransfer = currentPtr; // Assign this arrived process to Ptr to transfer    
-			              
-        } // Assigning new currentPtr based on if whether we traversed or not
-        // If we did not, new currentPtr is the head pointer which was the former 2nd node after former transferred node
-        // If we did, we assign it to the node after the former transferred node
-        prevPtr = currentPtr;
-		currentPtr = currentPtr->nextPtr;
+    outputText("Gantt chart: \n");
+    int currentTime = 0;
+    int sliceStartTime = 0;
+    int nextEventTime = 0;
+    sortJobQueueByArrival(JobQueue);
+    
+    long long numberOfEvents = 0;
+    while(*JobQueue != NULL || ReadyQueue.size > 0){
+    	numberOfEvents++;
+        longTermScheduler(JobQueue, &ReadyQueue, currentTime); // New arrivals may now go before the running process
+        if(ReadyQueue.size > 0){
+			runningProcess = peekHeap(&ReadyQueue);
+			recordFirstRun(runningProcess, currentTime);
+			if(runningProcess != dispatchedProcess){ // Running process was preempted, so its box is closed
+				if(dispatchedProcess != NULL){
+					outputGanttSlice(sliceStartTime, currentTime, dispatchedProcess);
+				}
+				dispatchedProcess = runningProcess;
+				sliceStartTime = currentTime;
+			}
+			nextEventTime = currentTime + runningProcess->remainingTime; // Time when the running process finishes
+			if(*JobQueue != NULL && (*JobQueue)->arrivalTime < nextEventTime){ // Unless another process arrives before that
+				nextEventTime = (*JobQueue)->arrivalTime;
+			}
+			runningProcess->remainingTime -= nextEventTime - currentTime;
+			currentTime = nextEventTime;
+			if(runningProcess->remainingTime == 0){
+				finishProcess(&ReadyQueue, &table, currentTime);
+				outputGanttSlice(sliceStartTime, currentTime, runningProcess);
+				dispatchedProcess = NULL;
+			}
+			else if(sortingMetric == LEASTREMAININGTIME){ // Key of the running process is lowered to its new remaining time before the arrival is compared to it
+				updateHeapKey(&ReadyQueue, runningProcess, runningProcess->remainingTime);
+			}
+        }
+        else{
+        	sliceStartTime = currentTime;
+            currentTime = (*JobQueue)->arrivalTime; // Nothing to execute, so jump straight to the next arrival (IDLE)
+            outputGanttSlice(sliceStartTime, currentTime, NULL);
+        }
     }
-    prevPtr = NULL;
-    currentPtr = *JobQueue;
-    while(currentPtr != NULL){
-    	if(currentPtr == PtrToTransfer){
-    		break;
+    outputGanttEnd(); // Gantt Chart of this algorithm is complete
+    freeReadyHeap(&ReadyQueue);
+    *JobQueue = linkProcessesByID(&table);
+    computeProcessMetrics(&table);
+    copyMetricsToProcesses(&table);
+	printTable(*JobQueue);
+	printAveragesHeader();
+	result = summarizeProcessTable(&table, currentTime);
+	result.numberOfEvents = numberOfEvents;
+	printAverages(&result); 
+	printLatencyStatistics(&table.statistics);
+	freeProcessTable(&table);
+	return result;
+}
+
+// This function runs a Multilevel Feedback Queue, where every arrival starts in the highest level (level 0)
+// A process that uses up the time quantum of its level is demoted one level, and every boost period all processes go back to level 0
+// Levels are Ready Rings indexed by a bitmap, so the next process is found with one find-first-set and taken in O(1)
+// A process only loses the CPU to a higher level, so an arrival preempts any process below level 0 but waits behind one in level 0
+struct SchedulingResult multilevelFeedbackQueue(struct Process **JobQueue, int numberOfProcesses, int timeQuantum){
+	outputSummary("\n\nProceeding to Multilevel Feedback Queue Scheduling...\n\n");
+	struct FeedbackQueues ReadyQueue;
+    struct Process *runningProcess = NULL;
+    struct Process *dispatchedProcess = NULL; // Process that started the current box of the Gantt Chart
+    struct ProcessTable table;
+    struct SchedulingResult result = {0, 0, 0, 0, 0, 0};
+    if(!initFeedbackQueues(&ReadyQueue, timeQuantum)){ // A level without a ring cannot take processes, so the algorithm stops
+    	freeFeedbackQueues(&ReadyQueue);
+    	return result;
+    }
+    if(!initProcessTable(&table, *JobQueue, numberOfProcesses)){ // Without the table there is nowhere to record results, so the algorithm stops
+    	freeFeedbackQueues(&ReadyQueue);
+    	return result;
+    }
+    
+    int boostPeriod = simulationOptions.mlfqBoostPeriod;
+    int level;
+    outputText("Time quantum of each level:");
+    for(level = 0; level < ReadyQueue.numberOfLevels; level++){
+    	outputText(" %d", ReadyQueue.timeQuanta[level]);
+	}
+    outputText((boostPeriod > 0) ? ", priority boost every %d\n" : ", no priority boost\n", boostPeriod);
+    outputText("Gantt chart: \n");
+    int nextBoostTime = boostPeriod;
+    int currentTime = 0;
+    int sliceStartTime = 0;
+    int sliceLength;
+    int demotedLevel = -1; // Level whose first process used up its time quantum, demoted once new arrivals have joined
+    sortJobQueueByArrival(JobQueue);
+    
+    long long numberOfEvents = 0;
+    while(*JobQueue != NULL || ReadyQueue.size > 0){
+    	numberOfEvents++;
+        longTermSchedulerToFeedback(JobQueue, &ReadyQueue, currentTime); // As in Round Robin, new processes ARRIVE FIRST before a demoted process moves
+        if(demotedLevel >= 0){
+        	struct Process *demotedProcess = popFromLevel(&ReadyQueue, demotedLevel);
+        	pushToLevel(&ReadyQueue, (demotedLevel + 1 < ReadyQueue.numberOfLevels) ? demotedLevel + 1 : demotedLevel, demotedProcess); // Lowest level is Round Robin
+        	demotedLevel = -1;
 		}
-		prevPtr = currentPtr;
-		currentPtr = currentPtr->nextPtr;
+		if(boostPeriod > 0 && currentTime >= nextBoostTime){
+			boostFeedbackQueues(&ReadyQueue);
+			nextBoostTime = (currentTime / boostPeriod + 1) * boostPeriod;
+		}
+        if(ReadyQueue.size > 0){
+        	level = highestReadyLevel(&ReadyQueue);
+			runningProcess = peekRing(&ReadyQueue.levels[level]);
+			recordFirstRun(runningProcess, currentTime);
+			if(runningProcess != dispatchedProcess){ // Running process was preempted or demoted, so its box is closed
+				if(dispatchedProcess != NULL){
+					outputGanttSlice(sliceStartTime, currentTime, dispatchedProcess);
+				}
+				dispatchedProcess = runningProcess;
+				sliceStartTime = currentTime;
+			}
+			sliceLength = ReadyQueue.timeQuanta[level] - runningProcess->levelTimeUsed; // Runs until the next event: end of its quantum,
+			if(runningProcess->remainingTime < sliceLength){ // completion, an arrival that may preempt it, or a boost
+				sliceLength = runningProcess->remainingTime;
+			}
+			if(level > 0 && *JobQueue != NULL && (*JobQueue)->arrivalTime - currentTime < sliceLength){
+				sliceLength = (*JobQueue)->arrivalTime - currentTime;
+			}
+			if(boostPeriod > 0 && nextBoostTime - currentTime < sliceLength){
+				sliceLength = nextBoostTime - currentTime;
+			}
+			currentTime += sliceLength;
+			runningProcess->remainingTime -= sliceLength;
+			runningProcess->levelTimeUsed += sliceLength;
+			if(runningProcess->remainingTime == 0){
+				terminateProcess(popFromLevel(&ReadyQueue, level), &table, currentTime);
+				outputGanttSlice(sliceStartTime, currentTime, runningProcess);
+				dispatchedProcess = NULL;
+			}
+			else if(runningProcess->levelTimeUsed == ReadyQueue.timeQuanta[level]){ // Used up its time quantum, so it moves down
+				demotedLevel = level;
+			}
+        }
+        else{
+        	sliceStartTime = currentTime;
+            currentTime = (*JobQueue)->arrivalTime; // Nothing to execute, so jump straight to the next arrival (IDLE)
+            outputGanttSlice(sliceStartTime, currentTime, NULL);
+        }
+    }
+    outputGanttEnd(); // Gantt Chart of this algorithm is complete
+    freeFeedbackQueues(&ReadyQueue);
+    *JobQueue = linkProcessesByID(&table);
+    computeProcessMetrics(&table);
+    copyMetricsToProcesses(&table);
+	printTable(*JobQueue);
+	printAveragesHeader();
+	result = summarizeProcessTable(&table, currentTime);
+	result.numberOfEvents = numberOfEvents;
+	printAverages(&result); 
+	printLatencyStatistics(&table.statistics);
+	freeProcessTable(&table);
+	return result;
+}
+
+// This function runs a Completely Fair Scheduler, where the process that has received the least CPU time, weighted by its priority, runs next
+// Each process has a virtual runtime that grows by the time it runs divided by its weight, so a process with higher priority ages slower
+// The running process is given its share of the targeted latency, which every process in the Run Tree should run within
+// With many processes, that share would be too small, so the latency grows with the number of processes
+// A low priority process still gets less than its share of the grown latency, so every slice is then raised to the minimum granularity, like in Linux
+// Taking the leftmost process is O(1), and putting it back after its slice is O(log n)
+struct SchedulingResult completelyFairScheduling(struct Process **JobQueue, int numberOfProcesses, int timeQuantum){
+	outputSummary("\n\nProceeding to Completely Fair Scheduling...\n\n");
+	struct RunTree ReadyQueue;
+    struct Process *runningProcess = NULL;
+    struct Process *dispatchedProcess = NULL; // Process that started the current box of the Gantt Chart
+    struct Process *preemptedProcess = NULL; // Process whose slice ended, put back once new arrivals have joined
+    struct ProcessTable table;
+    struct SchedulingResult result = {0, 0, 0, 0, 0, 0};
+    initRunTree(&ReadyQueue);
+    if(!initProcessTable(&table, *JobQueue, numberOfProcesses)){ // Without the table there is nowhere to record results, so the algorithm stops
+    	return result;
+    }
+    
+    int minimumGranularity = timeQuantum;
+    int targetedLatency = CFS_LATENCY_GRANULARITIES * timeQuantum;
+    outputText("Targeted latency: %d, minimum granularity: %d\n", targetedLatency, minimumGranularity);
+    outputText("Gantt chart: \n");
+    int currentTime = 0;
+    int sliceStartTime = 0;
+    int sliceLength;
+    int weight;
+    long long runnableProcesses;
+    long long period;
+    sortJobQueueByArrival(JobQueue);
+    
+    long long numberOfEvents = 0;
+    while(*JobQueue != NULL || ReadyQueue.size > 0 || preemptedProcess != NULL){
+    	numberOfEvents++;
+        longTermSchedulerToTree(JobQueue, &ReadyQueue, currentTime); // As in Round Robin, new processes ARRIVE FIRST before the preempted process goes back
+        if(preemptedProcess != NULL){
+        	insertToRunTree(&ReadyQueue, preemptedProcess);
+        	preemptedProcess = NULL;
+		}
+        if(ReadyQueue.size > 0){
+			runningProcess = ReadyQueue.leftmost;
+			removeFromRunTree(&ReadyQueue, runningProcess); // Running process is kept outside the tree, like in Linux
+			recordFirstRun(runningProcess, currentTime);
+			if(runningProcess != dispatchedProcess){ // Running process changed, so the box of the previous one is closed
+				if(dispatchedProcess != NULL){
+					outputGanttSlice(sliceStartTime, currentTime, dispatchedProcess);
+				}
+				dispatchedProcess = runningProcess;
+				sliceStartTime = currentTime;
+			}
+			weight = schedulingWeight(runningProcess->priority);
+			runnableProcesses = ReadyQueue.size + 1;
+			period = (runnableProcesses > CFS_LATENCY_GRANULARITIES) ? runnableProcesses * minimumGranularity : targetedLatency;
+			period = period * weight / (ReadyQueue.totalWeight + weight); // Share of the period given by the weight of the running process
+			if(period < minimumGranularity){ // No process is preempted before it has run for the minimum granularity
+				period = minimumGranularity;
+			}
+			sliceLength = (period < runningProcess->remainingTime) ? (int)period : runningProcess->remainingTime;
+			currentTime += sliceLength;
+			runningProcess->remainingTime -= sliceLength;
+			runningProcess->virtualRuntime += (long long)sliceLength * CFS_NICE_0_WEIGHT * CFS_NICE_0_WEIGHT / weight; // 1024 per time unit for MEDIUM priority
+			if(runningProcess->remainingTime == 0){
+				terminateProcess(runningProcess, &table, currentTime);
+				outputGanttSlice(sliceStartTime, currentTime, runningProcess);
+				dispatchedProcess = NULL;
+			}
+			else{
+				preemptedProcess = runningProcess;
+			}
+			struct Process *leastProcess = preemptedProcess; // Process with the least virtual runtime, whether in the tree or not
+			if(ReadyQueue.leftmost != NULL && (leastProcess == NULL || ReadyQueue.leftmost->virtualRuntime < leastProcess->virtualRuntime)){
+				leastProcess = ReadyQueue.leftmost;
+			}
+			if(leastProcess != NULL && leastProcess->virtualRuntime > ReadyQueue.minimumVirtualRuntime){ // Never decreases, so an arrival never starts with more credit than the processes already waiting
+				ReadyQueue.minimumVirtualRuntime = leastProcess->virtualRuntime;
+			}
+        }
+        else{
+        	sliceStartTime = currentTime;
+            currentTime = (*JobQueue)->arrivalTime; // Nothing to execute, so jump straight to the next arrival (IDLE)
+            outputGanttSlice(sliceStartTime, currentTime, NULL);
+        }
+    }
+    outputGanttEnd(); // Gantt Chart of this algorithm is complete
+    *JobQueue = linkProcessesByID(&table);
+    computeProcessMetrics(&table);
+    copyMetricsToProcesses(&table);
+	printTable(*JobQueue);
+	printAveragesHeader();
+	result = summarizeProcessTable(&table, currentTime);
+	result.numberOfEvents = numberOfEvents;
+	printAverages(&result); 
+	printLatencyStatistics(&table.statistics);
+	freeProcessTable(&table);
+	return result;
+}
+
+// This function runs the given algorithm, so that callers can choose an algorithm at runtime
+struct SchedulingResult runAlgorithm(enum SchedulingAlgorithm algorithm, struct Process **JobQueue, int numberOfProcesses, int timeQuantum){
+	if(algorithm == FCFS){
+		return firstComeFirstServe(JobQueue, numberOfProcesses);
+	}
+	else if(algorithm == FCFSNOIDLE){
+		return firstComeFirstServeWithoutIdleTime(JobQueue, numberOfProcesses);
+	}
+	else if(algorithm == ROUNDROBIN){
+		return roundRobinScheduling(JobQueue, numberOfProcesses, timeQuantum);
+	}
+	else if(algorithm == SJF){
+		return shortestJobFirst(JobQueue, numberOfProcesses);
+	}
+	else if(algorithm == SRTF){
+		return shortestRemainingTimeFirst(JobQueue, numberOfProcesses);
+	}
+	else if(algorithm == PRIORITY){
+		return preemptivePriorityScheduling(JobQueue, numberOfProcesses);
+	}
+	else if(algorithm == MLFQ){
+		return multilevelFeedbackQueue(JobQueue, numberOfProcesses, timeQuantum);
+	}
+	else if(algorithm == CFS){
+		return completelyFairScheduling(JobQueue, numberOfProcesses, timeQuantum);
+	}
+	return roundRobinSchedulingWithoutIdleTime(JobQueue, numberOfProcesses, timeQuantum);
+}
+
+// This function runs every algorithm on the same processes, either on one CPU or on the CPUs given in the command line
+void runEveryAlgorithm(struct Process **JobQueue, int numberOfProcesses, int timeQuantum){
+	if(simulationOptions.numberOfCpus > 0){ // Without idle time only makes sense for one CPU, so those variants are not run
+		multiCoreScheduling(FCFS, JobQueue, numberOfProcesses, 0);
+		multiCoreScheduling(ROUNDROBIN, JobQueue, numberOfProcesses, timeQuantum);
+		multiCoreScheduling(SJF, JobQueue, numberOfProcesses, 0);
+		multiCoreScheduling(SRTF, JobQueue, numberOfProcesses, 0);
+		multiCoreScheduling(PRIORITY, JobQueue, numberOfProcesses, 0);
+		return;
 	}
+	firstComeFirstServe(JobQueue, numberOfProcesses); // Execute FCFS
+	firstComeFirstServeWithoutIdleTime(JobQueue, numberOfProcesses); // Execute FCFS
+	roundRobinScheduling(JobQueue, numberOfProcesses, timeQuantum);
+	roundRobinSchedulingWithoutIdleTime(JobQueue, numberOfProcesses, timeQuantum);
+	shortestJobFirst(JobQueue, numberOfProcesses);
+	shortestRemainingTimeFirst(JobQueue, numberOfProcesses);
+	preemptivePriorityScheduling(JobQueue, numberOfProcesses);
+	multilevelFeedbackQueue(JobQueue, numberOfProcesses, timeQuantum);
+	completelyFairScheduling(JobQueue, numberOfProcesses, timeQuantum);
+}
+
+// longTermSchedulerNoIdleTime is used when no process has arrived yet, so it takes the process with the least arrival time and inserts it to Ready Queue
+void longTermSchedulerNoIdleTime(struct Process **JobQueue, struct ReadyHeap *ReadyQueue, int currentTime){
+    insertToHeap(ReadyQueue, takeEarliestArrival(JobQueue, currentTime)); // Insert it to the heap based on its sorting metric
+}
+
+// takeEarliestArrival removes the process with the least arrival time from the Job Queue and treats it as arriving at currentTime
+// Since Job Queue is sorted by arrival time, these are the processes at the front of the Job Queue
+// If several processes share the least arrival time, the last of them (in order of input) is taken
+struct Process *takeEarliestArrival(struct Process **JobQueue, int currentTime){
+    struct Process *PtrToTransfer = *JobQueue; // create a PtrToTransfer, which holds process to transfer to ready queue
+    struct Process *prevPtr = NULL;
+    
+    while(PtrToTransfer->nextPtr != NULL && PtrToTransfer->nextPtr->arrivalTime == (*JobQueue)->arrivalTime){ // Walk to the last process with the least arrival time
+        prevPtr = PtrToTransfer;
+        PtrToTransfer = PtrToTransfer->nextPtr;
+    }
     if(prevPtr == NULL) { // If prevPtr is null, we need to fix the headPointer to next node
         *JobQueue = (*JobQueue)->nextPtr;
     } 
-	else{ // If not, previousPointer now points to the node after currentPtr
-        prevPtr->nextPtr = currentPtr->nextPtr;
+	else{ // If not, previousPointer now points to the node after PtrToTransfer
+        prevPtr->nextPtr = PtrToTransfer->nextPtr;
     }
     PtrToTransfer->nextPtr = NULL; // Delink PtrToTransfer from JobQueue
-    insertToQueue(ReadyQueue, PtrToTransfer, sortingMetric); // Then insert it to the queue based on a sorting metric
-//    currentPtr = (prevPtr == NULL) ? *JobQueue : prevPtr->nextPtr;
+    PtrToTransfer->arrivalTime = currentTime; // Since CPU does not idle, the process is treated as arriving right now
+    return PtrToTransfer;
 }
 
-// longTermSchedulerNoIdleTime checks for processes that should HAVE ARRIVED given currentTime and inserts them to Ready Queue based on a sorting Metric 
-void longTermScheduler(struct Process **JobQueue, struct Process **ReadyQueue, int currentTime, enum SortingMetric sortingMetric){
-    struct Process *currentPtr = *JobQueue; // Assign first node of JobQueue to currentPtr
-    struct Process *PtrToTransfer = NULL; // create a PtrToTransfer, which holds process to transfer to ready queue
-    struct Process *prevPtr = NULL;
-    while(currentPtr != NULL){ // Loop through entire Job Queue
-        if(currentPtr->arrivalTime <= currentTime){ // Check if process should have arrived (lesser than or equal to currentTime)
-            PtrToTransfer = currentPtr; // Assign this arrived process to Ptr to transfer
-            if(prevPtr == NULL) { // If prevPtr is null, we need to fix the headPointer to next node
-                *JobQueue = (*JobQueue)->nextPtr;
-            } 
-			else{ // If not, previousPointer now points to the node after currentPtr
-                prevPtr->nextPtr = currentPtr->nextPtr;
-            }
-            PtrToTransfer->nextPtr = NULL; // Delink PtrToTransfer from JobQueue
-            insertToQueue(ReadyQueue, PtrToTransfer, sortingMetric); // Then insert it to the queue based on a sorting metric
-            currentPtr = (prevPtr == NULL) ? *JobQueue : prevPtr->nextPtr;
-        } // Assigning new currentPtr based on if whether we traversed or not
-        // If we did not, new currentPtr is the head pointer which was the former 2nd node after former transferred node
-        // If we did, we assign it to the node after the former transferred node
-		else{ // Otherwise, we walk to next node
-            prevPtr = currentPtr; 
-            currentPtr = currentPtr->nextPtr;
-        }
+// longTermScheduler checks for processes that should HAVE ARRIVED given currentTime and inserts them to Ready Queue based on a sorting Metric 
+// Job Queue is sorted by arrival time, so the front of the Job Queue works as a cursor: we only take processes from the front until one has not arrived yet
+void longTermScheduler(struct Process **JobQueue, struct ReadyHeap *ReadyQueue, int currentTime){
+    while(*JobQueue != NULL && (*JobQueue)->arrivalTime <= currentTime){ // Check if first process should have arrived (lesser than or equal to currentTime)
+        struct Process *PtrToTransfer = *JobQueue; // Assign this arrived process to Ptr to transfer
+        *JobQueue = (*JobQueue)->nextPtr; // Job Queue now starts at the next process
+        PtrToTransfer->nextPtr = NULL; // Delink PtrToTransfer from JobQueue
+        insertToHeap(ReadyQueue, PtrToTransfer); // Then insert it to the heap based on its sorting metric
+    }
+}
+
+// Same as longTermScheduler, but arrived processes join the back of a ring, which keeps them in order of arrival
+void longTermSchedulerToRing(struct Process **JobQueue, struct ReadyRing *ReadyQueue, int currentTime){
+    while(*JobQueue != NULL && (*JobQueue)->arrivalTime <= currentTime){
+        struct Process *PtrToTransfer = *JobQueue;
+        *JobQueue = (*JobQueue)->nextPtr;
+        PtrToTransfer->nextPtr = NULL;
+        pushToRing(ReadyQueue, PtrToTransfer);
     }
 }
 
+// This function returns how long the running process of Round Robin runs before the next scheduling decision
+// Normally this is one time quantum, but while the process is alone in the Ready Queue, rotating it only puts it back at the front
+// So every quantum up to and including the one that reaches the next arrival is merged into one slice, since the arrival only joins at the end of that quantum
+// If no quantum before the last one reaches the arrival, the process runs to completion
+// nextArrivalTime is the arrival time of the next process to arrive, or -1 if there is none
+int roundRobinSliceLength(int remainingTime, int readyProcesses, int currentTime, int nextArrivalTime, int timeQuantum){
+	int wholeQuanta;
+	if(readyProcesses > 1 || remainingTime <= timeQuantum){
+		return timeQuantum;
+	}
+	wholeQuanta = (remainingTime - 1) / timeQuantum; // Quantums that end before the process finishes
+	if(nextArrivalTime < 0 || (long long)currentTime + (long long)wholeQuanta * timeQuantum < nextArrivalTime){
+		return remainingTime; // Nothing arrives before the last quantum starts
+	}
+	wholeQuanta = (nextArrivalTime - currentTime + timeQuantum - 1) / timeQuantum; // Quantums until one ends at or after the next arrival, at least 1
+	return wholeQuanta * timeQuantum;
+}
+
 // Simple function that finds the correct spot for a process to be inserted then inserts it there basing on the passed sorting metric
+// The sorting metric is looked up once per insertion, the walk itself is specialized for it and never checks the metric again
 void insertToQueue(struct Process **Queue, struct Process *PtrToTransfer, enum SortingMetric sortingMetric){
-    struct Process *previousPtr = NULL;
-	struct Process *currentPtr = *Queue;
-	
-	if(sortingMetric == LEASTARRIVALTIME){ // We sort it with ascending arrival time, process that arrived first will be ahead in the queue
-		while(currentPtr != NULL && currentPtr->arrivalTime <= PtrToTransfer->arrivalTime){
-		    previousPtr = currentPtr;
-		    currentPtr = currentPtr->nextPtr;
-		}	
-	}
-	else if(sortingMetric == LEASTBURSTTIME){ // We sort it with ascending burst time, but if same burst time then apply FCFS
-		while (currentPtr != NULL && 
-    	(currentPtr->burstTime < PtrToTransfer->burstTime || 
-    	(currentPtr->burstTime == PtrToTransfer->burstTime && currentPtr->arrivalTime <= PtrToTransfer->arrivalTime))){
-        	previousPtr = currentPtr;
-        	currentPtr = currentPtr->nextPtr;
-    	}
-	}
-	else if(sortingMetric == HIGHESTPRIORITY){ // We sort it with ascending priority, but if same burst time then apply FCFS
-		while (currentPtr != NULL && 
-    	(currentPtr->priority < PtrToTransfer->priority || 
-    	(currentPtr->priority == PtrToTransfer->priority && currentPtr->arrivalTime <= PtrToTransfer->arrivalTime))){ 
-        	previousPtr = currentPtr;
-        	currentPtr = currentPtr->nextPtr;
-    	}
-	}
-	else if(sortingMetric == PROCESSID){ // We sort it with process ID (ascending, following original order of input)
-		while(currentPtr != NULL && currentPtr->processID <= PtrToTransfer->processID){
-        	previousPtr = currentPtr;
-        	currentPtr = currentPtr->nextPtr;
-    	}
-	}
-	
+	static void (*const insertToQueueFunctions[NUMBEROFSORTINGMETRICS])(struct Process **Queue, struct Process *PtrToTransfer) = {
+#define LIST_QUEUE_INSERT(metric, primaryKeyOfProcess, secondaryKeyOfProcess) insertToQueueBy##metric,
+		SORTING_METRICS(LIST_QUEUE_INSERT)
+#undef LIST_QUEUE_INSERT
+	};
+	insertToQueueFunctions[sortingMetric](Queue, PtrToTransfer);
+}
+
+// This function links a process into a queue right after previousPtr, or at the head if previousPtr is NULL
+void linkIntoQueue(struct Process **Queue, struct Process *previousPtr, struct Process *PtrToTransfer){
 	if(previousPtr == NULL){ // If we did not traverse at all
 	    PtrToTransfer->nextPtr = *Queue; // Assign transferred Process to point at first process in the queue
 	    *Queue = PtrToTransfer; // Then queue's head pointer will now be the transferred Process
 	}
 	else{ // Otherwise, we insert the transferred process between the prev and current Ptr
+	    PtrToTransfer->nextPtr = previousPtr->nextPtr; // transferred process now points to current pointer
 	    previousPtr->nextPtr = PtrToTransfer; // previous Pointer now points to transferred process
-	    PtrToTransfer->nextPtr = currentPtr; // transferred process now points to current pointer
 	}
 }
 
 // This function is applied to the first process in a Ready Queue, which has been deemed fully completed
-// First it resets remaining time and moves process to Termination Queue
-void finishProcess(struct Process **ReadyQueue, struct Process **TerminationQueue){
-    enum SortingMetric sortingMetric = PROCESSID; // So that terminationQueue follows original order of input of processes, we sort by ProcessID
-	struct Process *currentPtr = *ReadyQueue; // Assign currentPtr to first node of Ready Queue
+// First it records completion time in the Process Table, then resets remaining time
+void finishProcess(struct ReadyHeap *ReadyQueue, struct ProcessTable *table, int currentTime){
+	struct Process *currentPtr = popFromHeap(ReadyQueue); // Remove first process of Ready Queue
     if(currentPtr != NULL){
-    	currentPtr->remainingTime = currentPtr->burstTime; // Reset remaining time
-	    *ReadyQueue = (*ReadyQueue)->nextPtr; // ReadyQueue's first node is now the next node
-	    currentPtr->nextPtr = NULL; // Delink currentPtr from readyqueue
-	    insertToQueue(TerminationQueue, currentPtr, sortingMetric); // Insert it to termination queue based on processID
+    	terminateProcess(currentPtr, table, currentTime);
 	}       
 }
 
+// This function is applied to a process that is no longer in any queue, such as the running process of a CPU in multi-core mode
+// Results are written into the row of the process, so a completion costs O(1) instead of a sorted insert into a Termination Queue
+void terminateProcess(struct Process *PtrToTerminate, struct ProcessTable *table, int currentTime){
+	table->completionTime[PtrToTerminate->tableIndex] = currentTime;
+	table->arrivalTime[PtrToTerminate->tableIndex] = PtrToTerminate->arrivalTime; // Arrival time may have been changed by the algorithm, so it is recorded here
+	recordLatencies(&table->statistics, PtrToTerminate, currentTime);
+	PtrToTerminate->remainingTime = PtrToTerminate->burstTime; // Reset remaining time
+	PtrToTerminate->firstRunTime = -1;
+    PtrToTerminate->nextPtr = NULL; // Make sure PtrToTerminate is not linked to anything
+}
+
 void moveFirstToEnd(struct Process **ReadyQueue){ // Used in round robin to move first node of a queue to the back
     if (*ReadyQueue == NULL || (*ReadyQueue)->nextPtr == NULL) { // First check if ReadyQueue is not empty
         return;
@@ -482,61 +1492,2694 @@ void splitQueue(struct Process **JobQueue, struct Process **NewJobQueue, enum Pr
     }
 }
 
+// This function sorts the Job Queue by ascending arrival time using merge sort, which costs O(n log n) once per algorithm
+// Processes with the same arrival time keep their order of input, so the schedules do not change
+void sortJobQueueByArrival(struct Process **JobQueue){
+	struct Process *slowPtr = *JobQueue;
+	struct Process *fastPtr;
+	struct Process *secondHalf;
+	
+	if(slowPtr == NULL || slowPtr->nextPtr == NULL){ // Zero or one process is already sorted
+		return;
+	}
+	fastPtr = slowPtr->nextPtr;
+	while(fastPtr != NULL && fastPtr->nextPtr != NULL){ // fastPtr moves two nodes per step, so slowPtr stops at the middle
+		slowPtr = slowPtr->nextPtr;
+		fastPtr = fastPtr->nextPtr->nextPtr;
+	}
+	secondHalf = slowPtr->nextPtr; // Split the list in two halves
+	slowPtr->nextPtr = NULL;
+	
+	sortJobQueueByArrival(JobQueue); // Sort both halves, then merge them back
+	sortJobQueueByArrival(&secondHalf);
+	*JobQueue = mergeByArrival(*JobQueue, secondHalf);
+}
+
+struct Process *mergeByArrival(struct Process *firstList, struct Process *secondList){
+	struct Process head; // Temporary node so that the merged list does not need a special case for its first node
+	struct Process *tailPtr = &head;
+	
+	while(firstList != NULL && secondList != NULL){
+		if(firstList->arrivalTime <= secondList->arrivalTime){ // Taking from firstList on ties keeps the order of input
+			tailPtr->nextPtr = firstList;
+			firstList = firstList->nextPtr;
+		}
+		else{
+			tailPtr->nextPtr = secondList;
+			secondList = secondList->nextPtr;
+		}
+		tailPtr = tailPtr->nextPtr;
+	}
+	tailPtr->nextPtr = (firstList != NULL) ? firstList : secondList; // Attach whatever remains
+	return head.nextPtr;
+}
+
 // END OF SCHEDULING FUNCTIONS
-// START OF DATA FUNCTIONS
+// START OF PROCESS ARENA FUNCTIONS
 
-// This function prints the Table of Processes along with every relevant information of the process
-void printTable(struct Process *JobQueue) {
-	// Print table header
-	printf("\n\nTable containing processes information: \n");
-    printf("%-12s | %-12s | %-11s | %-9s | %-15s | %-16s | %-15s |\n",
-           "Process No.", "Arrival Time", "Burst Time", "Priority",
-           "Completion Time", "Turnaround Time", "Waiting Time");
+// The Process Arena hands out process nodes from large contiguous blocks, so loading n processes does not need n separate mallocs
+// Each new block is twice as large as the previous one, so the number of blocks only grows with log n
 
-    printf("------------------------------------------------------------------------------------------------------------\n");
-	// Traverse through JobQueue to print each process
-    struct Process *currentPtr = JobQueue;
-    while (currentPtr != NULL) {
-        printf("%-12d | %-12d | %-11d | %-9d | %-15d | %-16d | %-15d |\n",
-               currentPtr->processID,
-               currentPtr->originalArrivalTime,
-               currentPtr->burstTime,
-               currentPtr->priority,           
-               currentPtr->completionTime,
-               currentPtr->turnaroundTime,
-               currentPtr->waitingTime);
-        currentPtr->arrivalTime = currentPtr->originalArrivalTime;
-        currentPtr = currentPtr->nextPtr;
-    }
+void initProcessArena(struct ProcessArena *arena){
+	arena->firstSlab = NULL;
+	arena->currentSlab = NULL;
+	arena->tailPtr = NULL;
+	arena->processCount = 0;
 }
 
-// This function prints AveragesHeader
-void printAveragesHeader(){
-	printf("\nTable containing averages: \n");
-    printf("%-21s| %-20s| %-20s| %-10s|\n", 
-    "Total Completion Time", "Avg Turnaround Time", "Avg Waiting Time", "Throughput");
-    printf("------------------------------------------------------------------------------\n");
+struct Process *allocateProcess(struct ProcessArena *arena){
+	struct ProcessSlab *currentSlab = arena->currentSlab;
+	
+	while(currentSlab != NULL && currentSlab->used == currentSlab->capacity){ // Move to the next block that still has space (blocks are reused after clearProcesses)
+		if(currentSlab->nextSlab == NULL){
+			break;
+		}
+		currentSlab = currentSlab->nextSlab;
+	}
+	if(currentSlab == NULL || currentSlab->used == currentSlab->capacity){ // If every block is full, we allocate a new one
+		int newCapacity = (currentSlab != NULL) ? currentSlab->capacity * 2 : 64;
+		struct ProcessSlab *newSlab = malloc(sizeof(struct ProcessSlab));
+		if(newSlab == NULL){
+			return NULL;
+		}
+		newSlab->nodes = malloc(newCapacity * sizeof(struct Process));
+		if(newSlab->nodes == NULL){
+			free(newSlab);
+			return NULL;
+		}
+		newSlab->capacity = newCapacity;
+		newSlab->used = 0;
+		newSlab->nextSlab = NULL;
+		if(currentSlab == NULL){ // This is the first block of the arena
+			arena->firstSlab = newSlab;
+		}
+		else{
+			currentSlab->nextSlab = newSlab;
+		}
+		currentSlab = newSlab;
+	}
+	arena->currentSlab = currentSlab;
+	arena->processCount++;
+	return &currentSlab->nodes[currentSlab->used++];
 }
 
-// This function calculates the avgTAT and avgWT and then prints them as well as the total CT and throughPut
-void printAverages(struct Process *JobQueue, int totalCompletionTime, double numberOfProcesses){
-	struct Process *currentPtr = JobQueue;
-	int totalTurnaroundTime = 0, totalWaitingTime = 0; // Initialize to zero for proper summing
-	double averageTurnaroundTime, averageWaitingTime, throughput;
-	while(currentPtr != NULL){ // Traverse through queue for summing
-		totalTurnaroundTime += currentPtr->turnaroundTime;
-		//printf("SUM OF TOTALTAT: %d", totalTurnaroundTime);
-		totalWaitingTime += currentPtr->waitingTime;
+void freeProcessArena(struct ProcessArena *arena){ // Frees every block, which also frees every process allocated from the arena
+	struct ProcessSlab *currentSlab = arena->firstSlab;
+	while(currentSlab != NULL){
+		struct ProcessSlab *tempSlab = currentSlab;
+		currentSlab = currentSlab->nextSlab;
+		free(tempSlab->nodes);
+		free(tempSlab);
+	}
+	initProcessArena(arena);
+}
+
+// END OF PROCESS ARENA FUNCTIONS
+// START OF PROCESS TABLE FUNCTIONS
+
+// The Process Table keeps one array per field instead of one node per process
+// Algorithms only write completion times by index while running, then TAT and WT are computed in one pass over the arrays
+
+// This function creates the table from the Job Queue, giving each process its row number
+int initProcessTable(struct ProcessTable *table, struct Process *JobQueue, int numberOfProcesses){
+	struct Process *currentPtr = JobQueue;
+	int loopVar = 0;
+	
+	table->count = 0;
+	initLatencyStatistics(&table->statistics);
+	table->processes = malloc(numberOfProcesses * sizeof(struct Process *));
+	table->arrivalTime = malloc(numberOfProcesses * sizeof(int));
+	table->burstTime = malloc(numberOfProcesses * sizeof(int));
+	table->completionTime = malloc(numberOfProcesses * sizeof(int));
+	table->turnaroundTime = malloc(numberOfProcesses * sizeof(int));
+	table->waitingTime = malloc(numberOfProcesses * sizeof(int));
+	if(table->processes == NULL || table->arrivalTime == NULL || table->burstTime == NULL
+	|| table->completionTime == NULL || table->turnaroundTime == NULL || table->waitingTime == NULL){ // If ever memory allocation fails, we notify.
+		printf("Process Table cannot be created as there is no more memory.\n");
+		freeProcessTable(table);
+		return 0;
+	}
+	while(currentPtr != NULL && loopVar < numberOfProcesses){
+		currentPtr->tableIndex = loopVar;
+		table->processes[loopVar] = currentPtr;
+		table->arrivalTime[loopVar] = currentPtr->arrivalTime;
+		table->burstTime[loopVar] = currentPtr->burstTime;
+		table->completionTime[loopVar] = 0; // These are set to zero as the algorithm has yet to run
+		table->turnaroundTime[loopVar] = 0;
+		table->waitingTime[loopVar] = 0;
 		currentPtr = currentPtr->nextPtr;
+		loopVar++;
+	}
+	table->count = loopVar;
+	return 1;
+}
+
+void freeProcessTable(struct ProcessTable *table){
+	free(table->processes);
+	free(table->arrivalTime);
+	free(table->burstTime);
+	free(table->completionTime);
+	free(table->turnaroundTime);
+	free(table->waitingTime);
+	table->processes = NULL;
+	table->arrivalTime = table->burstTime = table->completionTime = table->turnaroundTime = table->waitingTime = NULL;
+	table->count = 0;
+}
+
+// This function computes TAT = CT - AT and WT = TAT - BT for every row, as straight loops over the arrays
+void computeProcessMetrics(struct ProcessTable *table){
+	const int *arrivalTime = table->arrivalTime;
+	const int *burstTime = table->burstTime;
+	const int *completionTime = table->completionTime;
+	int *turnaroundTime = table->turnaroundTime;
+	int *waitingTime = table->waitingTime;
+	int loopVar;
+	for(loopVar = 0; loopVar < table->count; loopVar++){
+		turnaroundTime[loopVar] = completionTime[loopVar] - arrivalTime[loopVar];
+	}
+	for(loopVar = 0; loopVar < table->count; loopVar++){
+		waitingTime[loopVar] = turnaroundTime[loopVar] - burstTime[loopVar];
+	}
+}
+
+void copyMetricsToProcesses(struct ProcessTable *table){ // Results are copied back into the nodes only so that printTable can show them
+	int loopVar;
+	for(loopVar = 0; loopVar < table->count; loopVar++){
+		table->processes[loopVar]->completionTime = table->completionTime[loopVar];
+		table->processes[loopVar]->turnaroundTime = table->turnaroundTime[loopVar];
+		table->processes[loopVar]->waitingTime = table->waitingTime[loopVar];
+	}
+}
+
+// This function links every process of the table in order of process ID, which is how the Table of Processes is printed
+// If the IDs are distinct and have no gaps (as in the test cases and generated workloads), each process goes straight to the slot of its ID in O(n)
+// Otherwise, the processes are sorted once by ID in O(n log n), with equal IDs kept in order of input
+struct Process *linkProcessesByID(struct ProcessTable *table){
+	struct Process **orderedProcesses;
+	struct Process *firstProcess;
+	int smallestID, largestID;
+	int isDense;
+	int loopVar;
+	
+	if(table->count == 0){
+		return NULL;
+	}
+	orderedProcesses = malloc(table->count * sizeof(struct Process *));
+	if(orderedProcesses == NULL){ // If there is no memory, processes are linked in order of input instead
+		for(loopVar = 0; loopVar < table->count; loopVar++){
+			table->processes[loopVar]->nextPtr = (loopVar + 1 < table->count) ? table->processes[loopVar + 1] : NULL;
+		}
+		return table->processes[0];
+	}
+	smallestID = largestID = table->processes[0]->processID;
+	for(loopVar = 1; loopVar < table->count; loopVar++){
+		int processID = table->processes[loopVar]->processID;
+		if(processID < smallestID){
+			smallestID = processID;
+		}
+		if(processID > largestID){
+			largestID = processID;
+		}
+	}
+	isDense = ((long long)largestID - smallestID + 1 == table->count);
+	if(isDense){
+		memset(orderedProcesses, 0, table->count * sizeof(struct Process *));
+		for(loopVar = 0; loopVar < table->count; loopVar++){
+			struct Process **slot = &orderedProcesses[table->processes[loopVar]->processID - smallestID];
+			if(*slot != NULL){ // Same ID twice, so some ID is missing and the slots cannot be used
+				isDense = 0;
+				break;
+			}
+			*slot = table->processes[loopVar];
+		}
+	}
+	if(!isDense){
+		memcpy(orderedProcesses, table->processes, table->count * sizeof(struct Process *));
+		qsort(orderedProcesses, table->count, sizeof(struct Process *), compareProcessIDs);
+	}
+	for(loopVar = 0; loopVar < table->count; loopVar++){
+		orderedProcesses[loopVar]->nextPtr = (loopVar + 1 < table->count) ? orderedProcesses[loopVar + 1] : NULL;
+	}
+	firstProcess = orderedProcesses[0];
+	free(orderedProcesses);
+	return firstProcess;
+}
+
+int compareProcessIDs(const void *first, const void *second){ // Orders by process ID, then by row so that equal IDs keep their order of input
+	const struct Process *firstProcess = *(struct Process *const *)first;
+	const struct Process *secondProcess = *(struct Process *const *)second;
+	if(firstProcess->processID != secondProcess->processID){
+		return (firstProcess->processID < secondProcess->processID) ? -1 : 1;
+	}
+	return (firstProcess->tableIndex < secondProcess->tableIndex) ? -1 : (firstProcess->tableIndex > secondProcess->tableIndex);
+}
+
+// END OF PROCESS TABLE FUNCTIONS
+// START OF READY HEAP FUNCTIONS
+
+// The Ready Heap replaces the sorted linked list walk of insertToQueue, which costs O(n) per insertion
+// Processes are ordered the same way insertToQueue orders them: by sorting metric, then arrival time, then order of insertion
+// Insertion and removal of the first process both cost O(log n)
+int initReadyHeap(struct ReadyHeap *heap, enum SortingMetric sortingMetric, int initialCapacity){
+	if(initialCapacity < 1){ // Heap should always be able to hold at least one process
+		initialCapacity = 1;
+	}
+	heap->entries = malloc(initialCapacity * sizeof(struct HeapEntry));
+	heap->size = 0;
+	heap->capacity = (heap->entries != NULL) ? initialCapacity : 0;
+	heap->nextSequence = 0;
+	heap->sortingMetric = sortingMetric;
+	static void (*const insertToHeapFunctions[NUMBEROFSORTINGMETRICS])(struct ReadyHeap *heap, struct Process *PtrToTransfer) = {
+#define LIST_HEAP_INSERT(metric, primaryKeyOfProcess, secondaryKeyOfProcess) insertToHeapBy##metric,
+		SORTING_METRICS(LIST_HEAP_INSERT)
+#undef LIST_HEAP_INSERT
+	};
+	heap->insertByMetric = insertToHeapFunctions[sortingMetric]; // Chosen once, so no insertion ever branches on the metric
+	if(heap->entries == NULL){ // If ever memory allocation fails, we notify.
+		printf("Ready Queue cannot be created as there is no more memory.\n");
+		return 0;
+	}
+	return 1;
+}
+
+void freeReadyHeap(struct ReadyHeap *heap){ // Processes inside are not freed, since they are still owned by the Job Queue
+	free(heap->entries);
+	heap->entries = NULL;
+	heap->size = 0;
+	heap->capacity = 0;
+}
+
+// This function inserts a process through the specialized insert of the heap's sorting metric
+void insertToHeap(struct ReadyHeap *heap, struct Process *PtrToTransfer){
+	heap->insertByMetric(heap, PtrToTransfer);
+}
+
+// Each line of SORTING_METRICS expands into its own key functions and inserts, with the ordering written out in full
+// The comparison is the same for every metric: lower key first, then lower tie-break, then order of insertion
+#define DEFINE_METRIC_FUNCTIONS(metric, primaryKeyOfProcess, secondaryKeyOfProcess) \
+int primaryKeyBy##metric(const struct Process *process){ \
+	return primaryKeyOfProcess; \
+} \
+int secondaryKeyBy##metric(const struct Process *process){ \
+	(void)process; /* Not every tie-break reads the process */ \
+	return secondaryKeyOfProcess; \
+} \
+void insertToHeapBy##metric(struct ReadyHeap *heap, struct Process *PtrToTransfer){ \
+	insertToHeapWithKey(heap, PtrToTransfer, primaryKeyBy##metric(PtrToTransfer), secondaryKeyBy##metric(PtrToTransfer)); \
+} \
+void insertToQueueBy##metric(struct Process **Queue, struct Process *PtrToTransfer){ \
+	int primaryKey = primaryKeyBy##metric(PtrToTransfer); \
+	int secondaryKey = secondaryKeyBy##metric(PtrToTransfer); \
+	struct Process *previousPtr = NULL; \
+	struct Process *currentPtr = *Queue; \
+	while(currentPtr != NULL && (primaryKeyBy##metric(currentPtr) < primaryKey || \
+	(primaryKeyBy##metric(currentPtr) == primaryKey && secondaryKeyBy##metric(currentPtr) <= secondaryKey))){ \
+		previousPtr = currentPtr; \
+		currentPtr = currentPtr->nextPtr; \
+	} \
+	linkIntoQueue(Queue, previousPtr, PtrToTransfer); \
+}
+SORTING_METRICS(DEFINE_METRIC_FUNCTIONS)
+#undef DEFINE_METRIC_FUNCTIONS
+
+// This function inserts a process with the given keys at the bottom of the heap, then lets it rise to its correct spot
+void insertToHeapWithKey(struct ReadyHeap *heap, struct Process *PtrToTransfer, int primaryKey, int secondaryKey){
+	struct HeapEntry entry;
+	entry.process = PtrToTransfer;
+	entry.primaryKey = primaryKey;
+	entry.secondaryKey = secondaryKey;
+	entry.sequence = heap->nextSequence++;
+	insertHeapEntry(heap, entry);
+}
+
+// This function inserts an entry as it is, so a process taken out of the heap can rejoin it with its original order of insertion
+void insertHeapEntry(struct ReadyHeap *heap, struct HeapEntry entry){
+	struct Process *PtrToTransfer = entry.process;
+	if(heap->size == heap->capacity){ // If heap is full, we double its capacity
+		int newCapacity = (heap->capacity > 0) ? heap->capacity * 2 : 1;
+		struct HeapEntry *newEntries = realloc(heap->entries, newCapacity * sizeof(struct HeapEntry));
+		if(newEntries == NULL){ // If ever memory allocation fails, we notify.
+			printf("Process %d is not inserted as there is no more memory.\n", PtrToTransfer->processID);
+			return;
+		}
+		heap->entries = newEntries;
+		heap->capacity = newCapacity;
+	}
+	heap->entries[heap->size] = entry;
+	PtrToTransfer->heapIndex = heap->size;
+	heap->size++;
+	siftUp(heap, heap->size - 1);
+}
+
+struct Process *peekHeap(struct ReadyHeap *heap){ // Returns the process to be executed next without removing it
+	return (heap->size > 0) ? heap->entries[0].process : NULL;
+}
+
+// This function removes the first process, then moves the last entry to the top and lets it sink to its correct spot
+struct Process *popFromHeap(struct ReadyHeap *heap){
+	if(heap->size == 0){
+		return NULL;
+	}
+	struct Process *firstProcess = heap->entries[0].process;
+	firstProcess->heapIndex = -1;
+	heap->size--;
+	if(heap->size > 0){
+		heap->entries[0] = heap->entries[heap->size];
+		siftDown(heap, 0);
+	}
+	return firstProcess;
+}
+
+// This function changes the key of a process already inside the heap, then lets it rise or sink to its new spot in O(log n)
+// The process is found through its heapIndex, so the heap does not need to be searched
+void updateHeapKey(struct ReadyHeap *heap, struct Process *process, int primaryKey){
+	int index = process->heapIndex;
+	if(index < 0 || index >= heap->size){ // Process is not in this heap
+		return;
+	}
+	int previousKey = heap->entries[index].primaryKey;
+	heap->entries[index].primaryKey = primaryKey;
+	if(primaryKey < previousKey){
+		siftUp(heap, index);
+	}
+	else{
+		siftDown(heap, index);
+	}
+}
+
+// Returns a negative value if first should be executed before second, and a positive value otherwise
+int compareHeapEntries(struct HeapEntry *first, struct HeapEntry *second){
+	if(first->primaryKey != second->primaryKey){
+		return (first->primaryKey < second->primaryKey) ? -1 : 1;
+	}
+	if(first->secondaryKey != second->secondaryKey){
+		return (first->secondaryKey < second->secondaryKey) ? -1 : 1;
+	}
+	return (first->sequence < second->sequence) ? -1 : 1; // Sequence is unique, so entries are never equal
+}
+
+void siftUp(struct ReadyHeap *heap, int index){ // Swap entry with its parent until parent goes first
+	struct HeapEntry entry = heap->entries[index];
+	while(index > 0){
+		int parentIndex = (index - 1) / 2;
+		if(compareHeapEntries(&heap->entries[parentIndex], &entry) < 0){
+			break;
+		}
+		heap->entries[index] = heap->entries[parentIndex];
+		heap->entries[index].process->heapIndex = index;
+		index = parentIndex;
+	}
+	heap->entries[index] = entry;
+	entry.process->heapIndex = index;
+}
+
+void siftDown(struct ReadyHeap *heap, int index){ // Swap entry with its earlier child until it goes before both children
+	struct HeapEntry entry = heap->entries[index];
+	while(1){
+		int childIndex = 2 * index + 1;
+		if(childIndex >= heap->size){
+			break;
+		}
+		if(childIndex + 1 < heap->size && compareHeapEntries(&heap->entries[childIndex + 1], &heap->entries[childIndex]) < 0){
+			childIndex++; // Right child goes first
+		}
+		if(compareHeapEntries(&entry, &heap->entries[childIndex]) < 0){
+			break;
+		}
+		heap->entries[index] = heap->entries[childIndex];
+		heap->entries[index].process->heapIndex = index;
+		index = childIndex;
+	}
+	heap->entries[index] = entry;
+	entry.process->heapIndex = index;
+}
+
+// END OF READY HEAP FUNCTIONS
+// START OF READY RING FUNCTIONS
+
+// The Ready Ring is used by Round Robin, whose Ready Queue is first-in first-out
+// Arrivals join the back in order of arrival, and a preempted process joins the back after the processes that arrived while it ran
+// This is the same order the Ready Heap gives with the arrival time (or time of preemption) as key, without the O(log n) cost
+
+int initReadyRing(struct ReadyRing *ring, int initialCapacity){
+	int capacity = 1;
+	while(capacity < initialCapacity){ // Round up to a power of two
+		capacity *= 2;
+	}
+	ring->slots = malloc(capacity * sizeof(struct Process *));
+	ring->head = 0;
+	ring->size = 0;
+	ring->capacity = (ring->slots != NULL) ? capacity : 0;
+	if(ring->slots == NULL){ // If ever memory allocation fails, we notify.
+		printf("Ready Queue cannot be created as there is no more memory.\n");
+		return 0;
+	}
+	return 1;
+}
+
+void freeReadyRing(struct ReadyRing *ring){ // Processes inside are not freed, since they are still owned by the Job Queue
+	free(ring->slots);
+	ring->slots = NULL;
+	ring->head = 0;
+	ring->size = 0;
+	ring->capacity = 0;
+}
+
+void pushToRing(struct ReadyRing *ring, struct Process *PtrToTransfer){ // Adds a process to the back of the ring
+	if(ring->size == ring->capacity){ // If ring is full, we double its capacity and unwrap it, so the front is at slot 0 again
+		int newCapacity = (ring->capacity > 0) ? ring->capacity * 2 : 1;
+		struct Process **newSlots = malloc(newCapacity * sizeof(struct Process *));
+		int loopVar;
+		if(newSlots == NULL){ // If ever memory allocation fails, we notify.
+			printf("Process %d is not inserted as there is no more memory.\n", PtrToTransfer->processID);
+			return;
+		}
+		for(loopVar = 0; loopVar < ring->size; loopVar++){
+			newSlots[loopVar] = ring->slots[(ring->head + loopVar) & (ring->capacity - 1)];
+		}
+		free(ring->slots);
+		ring->slots = newSlots;
+		ring->head = 0;
+		ring->capacity = newCapacity;
+	}
+	ring->slots[(ring->head + ring->size) & (ring->capacity - 1)] = PtrToTransfer;
+	ring->size++;
+}
+
+struct Process *peekRing(struct ReadyRing *ring){ // Returns the process to be executed next without removing it
+	return (ring->size > 0) ? ring->slots[ring->head] : NULL;
+}
+
+struct Process *popFromRing(struct ReadyRing *ring){ // Removes the process at the front of the ring
+	if(ring->size == 0){
+		return NULL;
+	}
+	struct Process *firstProcess = ring->slots[ring->head];
+	ring->head = (ring->head + 1) & (ring->capacity - 1);
+	ring->size--;
+	return firstProcess;
+}
+
+// Used in round robin to move the first process to the back, replacing the walk to the last node of moveFirstToEnd
+// The slot after the last process is where the front would be copied to, so the ring does not need to grow
+void rotateRing(struct ReadyRing *ring){
+	if(ring->size < 2){ // Nothing to move behind
+		return;
+	}
+	ring->slots[(ring->head + ring->size) & (ring->capacity - 1)] = ring->slots[ring->head];
+	ring->head = (ring->head + 1) & (ring->capacity - 1);
+}
+
+// END OF READY RING FUNCTIONS
+// START OF FEEDBACK QUEUE FUNCTIONS
+
+// The Feedback Queues are one Ready Ring per level of the Multilevel Feedback Queue, like the priority arrays of the Linux O(1) scheduler
+// Bit i of the bitmap is set while level i has processes, so the highest level with a process is the lowest set bit
+
+// This function creates the levels given in the command line, or 3 levels of timeQuantum, 2 * timeQuantum and 4 * timeQuantum
+int initFeedbackQueues(struct FeedbackQueues *queues, int timeQuantum){
+	int loopVar;
+	int created = 1;
+	queues->numberOfLevels = (simulationOptions.mlfqLevels > 0) ? simulationOptions.mlfqLevels : 3;
+	for(loopVar = 0; loopVar < queues->numberOfLevels; loopVar++){
+		queues->timeQuanta[loopVar] = (simulationOptions.mlfqLevels > 0) ? simulationOptions.mlfqTimeQuanta[loopVar] : timeQuantum << loopVar;
+		created = initReadyRing(&queues->levels[loopVar], 64) && created; // Each ring grows by itself, so levels do not need room for every process
+	}
+	queues->bitmap = 0;
+	queues->size = 0;
+	return created;
+}
+
+void freeFeedbackQueues(struct FeedbackQueues *queues){ // Processes inside are not freed, since they are still owned by the Job Queue
+	int loopVar;
+	for(loopVar = 0; loopVar < queues->numberOfLevels; loopVar++){
+		freeReadyRing(&queues->levels[loopVar]);
+	}
+	queues->bitmap = 0;
+	queues->size = 0;
+}
+
+void pushToLevel(struct FeedbackQueues *queues, int level, struct Process *PtrToTransfer){ // Adds a process to the back of a level, with a new time quantum
+	PtrToTransfer->queueLevel = level;
+	PtrToTransfer->levelTimeUsed = 0;
+	pushToRing(&queues->levels[level], PtrToTransfer);
+	queues->bitmap |= (uint32_t)1 << level;
+	queues->size++;
+}
+
+struct Process *popFromLevel(struct FeedbackQueues *queues, int level){ // Removes the process at the front of a level
+	struct Process *firstProcess = popFromRing(&queues->levels[level]);
+	if(queues->levels[level].size == 0){
+		queues->bitmap &= ~((uint32_t)1 << level);
+	}
+	queues->size--;
+	return firstProcess;
+}
+
+int highestReadyLevel(struct FeedbackQueues *queues){ // Lowest set bit of the bitmap, which must not be empty
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctz(queues->bitmap); // A single instruction on most CPUs
+#else
+	int level = 0;
+	while(!(queues->bitmap & ((uint32_t)1 << level))){
+		level++;
+	}
+	return level;
+#endif
+}
+
+// This function moves every process to level 0, keeping the order of levels and the order within each level
+// Processes already in level 0 keep their place in front and their time quantum
+void boostFeedbackQueues(struct FeedbackQueues *queues){
+	int level;
+	for(level = 1; level < queues->numberOfLevels; level++){
+		while(queues->levels[level].size > 0){
+			pushToLevel(queues, 0, popFromLevel(queues, level));
+		}
+	}
+}
+
+// Same as longTermSchedulerToRing, but every arrival joins the back of level 0
+void longTermSchedulerToFeedback(struct Process **JobQueue, struct FeedbackQueues *ReadyQueue, int currentTime){
+    while(*JobQueue != NULL && (*JobQueue)->arrivalTime <= currentTime){
+        struct Process *PtrToTransfer = *JobQueue;
+        *JobQueue = (*JobQueue)->nextPtr;
+        PtrToTransfer->nextPtr = NULL;
+        pushToLevel(ReadyQueue, 0, PtrToTransfer);
+    }
+}
+
+// END OF FEEDBACK QUEUE FUNCTIONS
+// START OF RUN TREE FUNCTIONS
+
+// The Run Tree is the Ready Queue of the Completely Fair Scheduler, a red-black tree of processes ordered by virtual runtime
+// Links are kept inside each process (like heapIndex for the Ready Heap), so inserting and removing never allocates
+// Processes with equal virtual runtime are ordered by when they were inserted, so they take turns like in Round Robin
+
+// Weight of each nice value from -20 to 19, the same table as the Linux scheduler, where each nice value gets about 10% less CPU than the one before
+const int niceToWeight[40] = {
+	88761, 71755, 56483, 46273, 36291,
+	29154, 23254, 18705, 14949, 11916,
+	9548, 7620, 6100, 4904, 3906,
+	3121, 2501, 1991, 1586, 1277,
+	1024, 820, 655, 526, 423,
+	335, 272, 215, 172, 137,
+	110, 87, 70, 56, 45,
+	36, 29, 23, 18, 15
+};
+
+// MEDIUM priority has nice 0, and each step of priority is 5 nice values, so HIGH gets about 3 times the CPU of MEDIUM and LOW about a third
+int schedulingWeight(int priority){
+	int nice = (priority - MEDIUM) * 5;
+	if(nice < -20){
+		nice = -20;
+	}
+	else if(nice > 19){
+		nice = 19;
+	}
+	return niceToWeight[nice + 20];
+}
+
+void initRunTree(struct RunTree *tree){
+	tree->root = NULL;
+	tree->leftmost = NULL;
+	tree->size = 0;
+	tree->totalWeight = 0;
+	tree->minimumVirtualRuntime = 0;
+	tree->nextSequence = 0;
+}
+
+int comparePlacesInTree(struct Process *first, struct Process *second){ // Negative if first goes before second
+	if(first->virtualRuntime != second->virtualRuntime){
+		return (first->virtualRuntime < second->virtualRuntime) ? -1 : 1;
+	}
+	return (first->treeSequence < second->treeSequence) ? -1 : 1;
+}
+
+// This function makes child take the place of node under the parent of node
+void replaceTreeChild(struct RunTree *tree, struct Process *node, struct Process *child){
+	struct Process *parent = node->treeParent;
+	if(parent == NULL){
+		tree->root = child;
+	}
+	else if(parent->treeLeft == node){
+		parent->treeLeft = child;
+	}
+	else{
+		parent->treeRight = child;
+	}
+	if(child != NULL){
+		child->treeParent = parent;
+	}
+}
+
+void rotateTreeLeft(struct RunTree *tree, struct Process *node){ // Right child of node takes its place, and node becomes its left child
+	struct Process *pivot = node->treeRight;
+	node->treeRight = pivot->treeLeft;
+	if(pivot->treeLeft != NULL){
+		pivot->treeLeft->treeParent = node;
+	}
+	replaceTreeChild(tree, node, pivot);
+	pivot->treeLeft = node;
+	node->treeParent = pivot;
+}
+
+void rotateTreeRight(struct RunTree *tree, struct Process *node){ // Mirror of rotateTreeLeft
+	struct Process *pivot = node->treeLeft;
+	node->treeLeft = pivot->treeRight;
+	if(pivot->treeRight != NULL){
+		pivot->treeRight->treeParent = node;
+	}
+	replaceTreeChild(tree, node, pivot);
+	pivot->treeRight = node;
+	node->treeParent = pivot;
+}
+
+// This function inserts a process by its virtual runtime, then recolors and rotates until no red node has a red parent
+void insertToRunTree(struct RunTree *tree, struct Process *PtrToTransfer){
+	struct Process *parent = NULL;
+	struct Process *currentPtr = tree->root;
+	int isLeftmost = 1; // Stays 1 only if every step goes left, in which case the process is the new leftmost
+	
+	PtrToTransfer->treeSequence = tree->nextSequence++;
+	while(currentPtr != NULL){
+		parent = currentPtr;
+		if(comparePlacesInTree(PtrToTransfer, currentPtr) < 0){
+			currentPtr = currentPtr->treeLeft;
+		}
+		else{
+			currentPtr = currentPtr->treeRight;
+			isLeftmost = 0;
+		}
+	}
+	PtrToTransfer->treeParent = parent;
+	PtrToTransfer->treeLeft = NULL;
+	PtrToTransfer->treeRight = NULL;
+	PtrToTransfer->treeRed = 1;
+	if(parent == NULL){
+		tree->root = PtrToTransfer;
+	}
+	else if(comparePlacesInTree(PtrToTransfer, parent) < 0){
+		parent->treeLeft = PtrToTransfer;
+	}
+	else{
+		parent->treeRight = PtrToTransfer;
+	}
+	if(isLeftmost){
+		tree->leftmost = PtrToTransfer;
+	}
+	tree->size++;
+	tree->totalWeight += schedulingWeight(PtrToTransfer->priority);
+	
+	struct Process *node = PtrToTransfer;
+	while(node->treeParent != NULL && node->treeParent->treeRed){
+		parent = node->treeParent;
+		struct Process *grandparent = parent->treeParent; // Exists, since the root is black
+		struct Process *uncle = (parent == grandparent->treeLeft) ? grandparent->treeRight : grandparent->treeLeft;
+		if(uncle != NULL && uncle->treeRed){ // Red uncle: push the blackness of the grandparent down and continue from it
+			parent->treeRed = 0;
+			uncle->treeRed = 0;
+			grandparent->treeRed = 1;
+			node = grandparent;
+			continue;
+		}
+		if(parent == grandparent->treeLeft){
+			if(node == parent->treeRight){ // Turn the inner case into the outer case
+				rotateTreeLeft(tree, parent);
+				node = parent;
+				parent = node->treeParent;
+			}
+			rotateTreeRight(tree, grandparent);
+		}
+		else{
+			if(node == parent->treeLeft){
+				rotateTreeRight(tree, parent);
+				node = parent;
+				parent = node->treeParent;
+			}
+			rotateTreeLeft(tree, grandparent);
+		}
+		parent->treeRed = 0;
+		grandparent->treeRed = 1;
+		break;
+	}
+	tree->root->treeRed = 0;
+}
+
+// This function removes a process from the tree, then recolors and rotates until every path has the same number of black nodes again
+void removeFromRunTree(struct RunTree *tree, struct Process *PtrToRemove){
+	struct Process *child;
+	struct Process *parent;
+	int removedRed;
+	
+	if(tree->leftmost == PtrToRemove){ // Next leftmost is the smallest of its right subtree, or else its parent
+		struct Process *nextLeftmost = PtrToRemove->treeRight;
+		if(nextLeftmost != NULL){
+			while(nextLeftmost->treeLeft != NULL){
+				nextLeftmost = nextLeftmost->treeLeft;
+			}
+		}
+		else{
+			nextLeftmost = PtrToRemove->treeParent;
+		}
+		tree->leftmost = nextLeftmost;
+	}
+	if(PtrToRemove->treeLeft == NULL || PtrToRemove->treeRight == NULL){ // At most one child, which takes its place
+		child = (PtrToRemove->treeLeft != NULL) ? PtrToRemove->treeLeft : PtrToRemove->treeRight;
+		parent = PtrToRemove->treeParent;
+		removedRed = PtrToRemove->treeRed;
+		replaceTreeChild(tree, PtrToRemove, child);
+	}
+	else{ // Two children: the next process in order (which has no left child) is moved into its place
+		struct Process *successor = PtrToRemove->treeRight;
+		while(successor->treeLeft != NULL){
+			successor = successor->treeLeft;
+		}
+		child = successor->treeRight;
+		removedRed = successor->treeRed;
+		if(successor->treeParent == PtrToRemove){
+			parent = successor;
+		}
+		else{
+			parent = successor->treeParent;
+			replaceTreeChild(tree, successor, child);
+			successor->treeRight = PtrToRemove->treeRight;
+			successor->treeRight->treeParent = successor;
+		}
+		replaceTreeChild(tree, PtrToRemove, successor);
+		successor->treeLeft = PtrToRemove->treeLeft;
+		successor->treeLeft->treeParent = successor;
+		successor->treeRed = PtrToRemove->treeRed;
+	}
+	tree->size--;
+	tree->totalWeight -= schedulingWeight(PtrToRemove->priority);
+	PtrToRemove->treeParent = NULL;
+	PtrToRemove->treeLeft = NULL;
+	PtrToRemove->treeRight = NULL;
+	if(removedRed){ // Removing a red node never changes the number of black nodes on a path
+		return;
+	}
+	
+	while(child != tree->root && (child == NULL || !child->treeRed)){ // child is missing one black node on its paths
+		if(child == parent->treeLeft){
+			struct Process *sibling = parent->treeRight;
+			if(sibling->treeRed){
+				sibling->treeRed = 0;
+				parent->treeRed = 1;
+				rotateTreeLeft(tree, parent);
+				sibling = parent->treeRight;
+			}
+			if((sibling->treeLeft == NULL || !sibling->treeLeft->treeRed) && (sibling->treeRight == NULL || !sibling->treeRight->treeRed)){
+				sibling->treeRed = 1; // Sibling gives up a black node too, so the missing node moves up to the parent
+				child = parent;
+				parent = child->treeParent;
+				continue;
+			}
+			if(sibling->treeRight == NULL || !sibling->treeRight->treeRed){
+				sibling->treeLeft->treeRed = 0;
+				sibling->treeRed = 1;
+				rotateTreeRight(tree, sibling);
+				sibling = parent->treeRight;
+			}
+			sibling->treeRed = parent->treeRed;
+			parent->treeRed = 0;
+			sibling->treeRight->treeRed = 0;
+			rotateTreeLeft(tree, parent);
+		}
+		else{ // Mirror of the case above
+			struct Process *sibling = parent->treeLeft;
+			if(sibling->treeRed){
+				sibling->treeRed = 0;
+				parent->treeRed = 1;
+				rotateTreeRight(tree, parent);
+				sibling = parent->treeLeft;
+			}
+			if((sibling->treeLeft == NULL || !sibling->treeLeft->treeRed) && (sibling->treeRight == NULL || !sibling->treeRight->treeRed)){
+				sibling->treeRed = 1;
+				child = parent;
+				parent = child->treeParent;
+				continue;
+			}
+			if(sibling->treeLeft == NULL || !sibling->treeLeft->treeRed){
+				sibling->treeRight->treeRed = 0;
+				sibling->treeRed = 1;
+				rotateTreeLeft(tree, sibling);
+				sibling = parent->treeLeft;
+			}
+			sibling->treeRed = parent->treeRed;
+			parent->treeRed = 0;
+			sibling->treeLeft->treeRed = 0;
+			rotateTreeRight(tree, parent);
+		}
+		child = tree->root;
+	}
+	if(child != NULL){
+		child->treeRed = 0;
+	}
+}
+
+// Same as longTermSchedulerToRing, but arrivals start at the least virtual runtime of the tree, so they cannot take the CPU for as long as they were absent
+void longTermSchedulerToTree(struct Process **JobQueue, struct RunTree *ReadyQueue, int currentTime){
+    while(*JobQueue != NULL && (*JobQueue)->arrivalTime <= currentTime){
+        struct Process *PtrToTransfer = *JobQueue;
+        *JobQueue = (*JobQueue)->nextPtr;
+        PtrToTransfer->nextPtr = NULL;
+        PtrToTransfer->virtualRuntime = ReadyQueue->minimumVirtualRuntime;
+        insertToRunTree(ReadyQueue, PtrToTransfer);
+    }
+}
+
+// END OF RUN TREE FUNCTIONS
+// START OF DATA FUNCTIONS
+
+// This function prints the Table of Processes along with every relevant information of the process
+void printTable(struct Process *JobQueue) {
+	// Print table header
+	outputText("\n\nTable containing processes information: \n");
+    outputText("%-12s | %-12s | %-11s | %-9s | %-15s | %-16s | %-15s |\n",
+           "Process No.", "Arrival Time", "Burst Time", "Priority",
+           "Completion Time", "Turnaround Time", "Waiting Time");
+
+    outputText("------------------------------------------------------------------------------------------------------------\n");
+	// Traverse through JobQueue to print each process
+    struct Process *currentPtr = JobQueue;
+    while (currentPtr != NULL) {
+        outputText("%-12d | %-12d | %-11d | %-9d | %-15d | %-16d | %-15d |\n",
+               currentPtr->processID,
+               currentPtr->originalArrivalTime,
+               currentPtr->burstTime,
+               currentPtr->priority,           
+               currentPtr->completionTime,
+               currentPtr->turnaroundTime,
+               currentPtr->waitingTime);
+        currentPtr->arrivalTime = currentPtr->originalArrivalTime;
+        currentPtr = currentPtr->nextPtr;
+    }
+}
+
+// This function prints AveragesHeader
+void printAveragesHeader(){
+	outputSummary("\nTable containing averages: \n");
+    outputSummary("%-21s| %-20s| %-20s| %-10s|\n", 
+    "Total Completion Time", "Avg Turnaround Time", "Avg Waiting Time", "Throughput");
+    outputSummary("------------------------------------------------------------------------------\n");
+}
+
+// This function returns the totals of TAT and WT, which printAverages turns into averages
+struct SchedulingResult summarizeProcessTable(struct ProcessTable *table, int totalCompletionTime){
+	struct SchedulingResult result;
+	result.totalCompletionTime = totalCompletionTime;
+	result.numberOfEvents = 0; // Counted by the algorithm itself
+	copyStatisticsToResult(&table->statistics, &result); // Totals were summed as processes finished, so the rows are not read again
+	return result;
+}
+
+// This function calculates the avgTAT and avgWT and then prints them as well as the total CT and throughPut
+void printAverages(struct SchedulingResult *result){
+	double numberOfProcesses = result->numberOfProcesses; // Casted to double to allow decimal division
+	double averageTurnaroundTime, averageWaitingTime, throughput;
+	averageTurnaroundTime = result->totalTurnaroundTime / numberOfProcesses;
+	averageWaitingTime = result->totalWaitingTime / numberOfProcesses;
+	throughput = numberOfProcesses / result->totalCompletionTime;
+    outputSummary("%-21d| %-20.3f| %-20.3f| %-10.3f|\n", // Print the information
+           result->totalCompletionTime, averageTurnaroundTime, averageWaitingTime, throughput);
+}
+
+// END OF DATA FUNCTIONS
+// START OF STATISTICS FUNCTIONS
+
+// Statistics are updated once per finished process in O(1) and use the same memory for 10 processes or 10^8 processes
+// Mean and standard deviation are exact (up to floating point), while percentiles come from the histogram and are within 1/16 of the exact value
+
+void initOnlineStatistic(struct OnlineStatistic *statistic){
+	memset(statistic, 0, sizeof(struct OnlineStatistic));
+}
+
+void addToStatistic(struct OnlineStatistic *statistic, int value){
+	double deviation = value - statistic->mean;
+	statistic->count++;
+	statistic->total += value;
+	statistic->mean += deviation / statistic->count;
+	statistic->squaredDeviations += deviation * (value - statistic->mean);
+	if(statistic->count == 1 || value > statistic->maximum){
+		statistic->maximum = value;
+	}
+	statistic->buckets[histogramIndex(value)]++;
+}
+
+// This function adds every value of other to statistic, as if they had been added one by one (Chan's method for the deviations)
+void mergeStatistic(struct OnlineStatistic *statistic, struct OnlineStatistic *other){
+	long count = statistic->count + other->count;
+	double deviation = other->mean - statistic->mean;
+	int loopVar;
+	if(other->count == 0){
+		return;
+	}
+	if(statistic->count == 0 || other->maximum > statistic->maximum){
+		statistic->maximum = other->maximum;
+	}
+	statistic->squaredDeviations += other->squaredDeviations + deviation * deviation * statistic->count * other->count / count;
+	statistic->mean += deviation * other->count / count;
+	statistic->count = count;
+	statistic->total += other->total;
+	for(loopVar = 0; loopVar < HISTOGRAM_BUCKETS; loopVar++){
+		statistic->buckets[loopVar] += other->buckets[loopVar];
+	}
+}
+
+// Values below 2 * HISTOGRAM_SUB_BUCKETS get a bucket each, then every power of two is split into HISTOGRAM_SUB_BUCKETS buckets
+int histogramIndex(int value){
+	int shift = 0;
+	if(value < 0){ // Latencies are never negative, but a bucket is still needed
+		value = 0;
+	}
+	while((value >> shift) >= 2 * HISTOGRAM_SUB_BUCKETS){ // Shift until only the leading 5 bits remain
+		shift++;
+	}
+	return shift * HISTOGRAM_SUB_BUCKETS + (value >> shift);
+}
+
+int histogramUpperBound(int index){ // Largest value that falls in the bucket
+	int shift, leadingBits;
+	if(index < 2 * HISTOGRAM_SUB_BUCKETS){
+		return index;
+	}
+	shift = index / HISTOGRAM_SUB_BUCKETS - 1;
+	leadingBits = index - shift * HISTOGRAM_SUB_BUCKETS;
+	return (int)((((long long)leadingBits + 1) << shift) - 1);
+}
+
+// This function returns the smallest bucket bound below which at least the given fraction of values fall (never more than the maximum)
+int statisticPercentile(struct OnlineStatistic *statistic, double fraction){
+	long long rank = (long long)ceil(fraction * statistic->count);
+	long long seen = 0;
+	int loopVar;
+	if(statistic->count == 0){
+		return 0;
+	}
+	if(rank < 1){
+		rank = 1;
+	}
+	for(loopVar = 0; loopVar < HISTOGRAM_BUCKETS; loopVar++){
+		seen += statistic->buckets[loopVar];
+		if(seen >= rank){
+			int upperBound = histogramUpperBound(loopVar);
+			return (upperBound < statistic->maximum) ? upperBound : statistic->maximum;
+		}
+	}
+	return statistic->maximum;
+}
+
+double statisticStandardDeviation(struct OnlineStatistic *statistic){
+	return (statistic->count > 1) ? sqrt(statistic->squaredDeviations / statistic->count) : 0.0;
+}
+
+void initLatencyStatistics(struct LatencyStatistics *statistics){
+	initOnlineStatistic(&statistics->turnaroundTime);
+	initOnlineStatistic(&statistics->waitingTime);
+	initOnlineStatistic(&statistics->responseTime);
+}
+
+void recordFirstRun(struct Process *runningProcess, int currentTime){ // Called whenever a process is about to run, but only the first time counts
+	if(runningProcess->firstRunTime < 0){
+		runningProcess->firstRunTime = currentTime;
+	}
+}
+
+// This function adds the TAT, WT and response time of a process that finishes at currentTime
+void recordLatencies(struct LatencyStatistics *statistics, struct Process *finishedProcess, int currentTime){
+	int turnaroundTime = currentTime - finishedProcess->arrivalTime;
+	addToStatistic(&statistics->turnaroundTime, turnaroundTime);
+	addToStatistic(&statistics->waitingTime, turnaroundTime - finishedProcess->burstTime);
+	addToStatistic(&statistics->responseTime, finishedProcess->firstRunTime - finishedProcess->arrivalTime);
+}
+
+void copyStatisticsToResult(struct LatencyStatistics *statistics, struct SchedulingResult *result){
+	result->totalTurnaroundTime = statistics->turnaroundTime.total;
+	result->totalWaitingTime = statistics->waitingTime.total;
+	result->numberOfProcesses = statistics->turnaroundTime.count;
+	result->percentile99WaitingTime = statisticPercentile(&statistics->waitingTime, 0.99);
+}
+
+// This function prints mean, standard deviation, percentiles and maximum of every latency
+void printLatencyStatistics(struct LatencyStatistics *statistics){
+	outputSummary("\nTable containing latencies: \n");
+	outputSummary("%-16s| %-10s| %-10s| %-8s| %-8s| %-8s| %-8s|\n", "Latency", "Mean", "Std Dev", "p50", "p95", "p99", "Max");
+	outputSummary("--------------------------------------------------------------------------------\n");
+	printStatisticRow("Turnaround Time", &statistics->turnaroundTime);
+	printStatisticRow("Waiting Time", &statistics->waitingTime);
+	printStatisticRow("Response Time", &statistics->responseTime);
+}
+
+void printStatisticRow(const char *name, struct OnlineStatistic *statistic){
+	outputSummary("%-16s| %-10.3f| %-10.3f| %-8d| %-8d| %-8d| %-8d|\n", name, statistic->mean, statisticStandardDeviation(statistic),
+		statisticPercentile(statistic, 0.50), statisticPercentile(statistic, 0.95), statisticPercentile(statistic, 0.99), statistic->maximum);
+}
+
+// END OF STATISTICS FUNCTIONS
+// START OF TRACE FUNCTIONS
+
+// A text trace has one process per line: process ID, arrival time, burst time and priority, separated by spaces
+// Empty lines and lines starting with # are skipped
+// A binary trace is a TraceHeader followed by fixed-width TraceRecords, which are memory-mapped and read in place
+
+// This function opens a trace and detects if it is text or binary from its first 4 bytes, returning 0 if it cannot be read
+int openTraceStream(struct TraceStream *stream, const char *path){
+	struct TraceHeader header;
+	
+	memset(stream, 0, sizeof(struct TraceStream));
+	stream->file = fopen(path, "rb");
+	if(stream->file == NULL){
+		printf("Trace %s cannot be opened.\n", path);
+		return 0;
+	}
+	if(fread(&header, sizeof(struct TraceHeader), 1, stream->file) == 1 && memcmp(header.magic, TRACE_MAGIC, 4) == 0){
+		if(header.version != TRACE_VERSION || header.recordSize != sizeof(struct TraceRecord)){
+			printf("Trace %s has an unsupported binary format.\n", path);
+			fclose(stream->file);
+			stream->file = NULL;
+			return 0;
+		}
+		stream->isBinary = 1;
+#ifndef _WIN32
+		struct stat fileStatus;
+		int fileDescriptor = fileno(stream->file);
+		if(fstat(fileDescriptor, &fileStatus) == 0 && fileStatus.st_size > (off_t)sizeof(struct TraceHeader)){
+			if((fileStatus.st_size - sizeof(struct TraceHeader)) % sizeof(struct TraceRecord) != 0){ // A truncated file would lose its last process without notice
+				printf("Trace %s ends with a partial record.\n", path);
+				fclose(stream->file);
+				stream->file = NULL;
+				return 0;
+			}
+			void *mappedBase = mmap(NULL, fileStatus.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+			if(mappedBase != MAP_FAILED){ // Records are read straight from the mapped file, without copying them
+				madvise(mappedBase, fileStatus.st_size, MADV_SEQUENTIAL);
+				stream->mappedBase = mappedBase;
+				stream->mappedLength = fileStatus.st_size;
+				stream->mappedRecords = (const struct TraceRecord *)((const char *)mappedBase + sizeof(struct TraceHeader));
+				stream->recordCount = (fileStatus.st_size - sizeof(struct TraceHeader)) / sizeof(struct TraceRecord);
+				return 1;
+			}
+		}
+#endif
+		stream->chunk = malloc(TRACE_CHUNK_RECORDS * sizeof(struct TraceRecord)); // If mmap is not available, records are read in chunks
+		if(stream->chunk == NULL){
+			printf("Trace %s cannot be read as there is no more memory.\n", path);
+			fclose(stream->file);
+			stream->file = NULL;
+			return 0;
+		}
+		return 1;
+	}
+	rewind(stream->file); // Not a binary trace, so it is read from the start as text
+	return 1;
+}
+
+// This function applies the same checks to a binary record as to a line of a text trace, returning NULL if the record is invalid
+const struct TraceRecord *validBinaryRecord(struct TraceStream *stream, const struct TraceRecord *record){
+	if(record->arrivalTime < 0 || record->burstTime <= 0){
+		printf("Record %ld of the trace is not a valid process.\n", stream->nextRecord);
+		stream->error = 1;
+		return NULL;
+	}
+	return record;
+}
+
+// This function returns the next record of the trace, or NULL once the trace ends or has an error
+// The record is only valid until the next call, since it points inside the mapped file, the chunk or the scratch record
+const struct TraceRecord *nextTraceRecord(struct TraceStream *stream){
+	const struct TraceRecord *record;
+	if(stream->isBinary && stream->mappedRecords != NULL){
+		if(stream->nextRecord == stream->recordCount){
+			return NULL;
+		}
+		record = &stream->mappedRecords[stream->nextRecord++];
+		return validBinaryRecord(stream, record);
+	}
+	if(stream->isBinary){
+		if(stream->chunkIndex == stream->chunkCount){ // Current chunk is used up, so read the next one
+			size_t bytesRead = fread(stream->chunk, 1, TRACE_CHUNK_RECORDS * sizeof(struct TraceRecord), stream->file);
+			stream->chunkCount = bytesRead / sizeof(struct TraceRecord);
+			stream->chunkIndex = 0;
+			if(bytesRead % sizeof(struct TraceRecord) != 0){ // Only the end of the file can cut a record short
+				printf("Trace ends with a partial record.\n");
+				stream->error = 1;
+				return NULL;
+			}
+			if(stream->chunkCount == 0){
+				return NULL;
+			}
+		}
+		stream->nextRecord++;
+		record = &stream->chunk[stream->chunkIndex++];
+		return validBinaryRecord(stream, record);
+	}
+	char line[TRACE_LINE_LENGTH];
+	while(fgets(line, TRACE_LINE_LENGTH, stream->file) != NULL){
+		char *firstCharacter = line;
+		int processID, arrivalTime, burstTime, priority;
+		stream->lineNumber++;
+		while(*firstCharacter == ' ' || *firstCharacter == '\t'){
+			firstCharacter++;
+		}
+		if(*firstCharacter == '#' || *firstCharacter == '\n' || *firstCharacter == '\r' || *firstCharacter == '\0'){ // Skip comments and empty lines
+			continue;
+		}
+		if(sscanf(firstCharacter, "%d %d %d %d", &processID, &arrivalTime, &burstTime, &priority) != 4 || arrivalTime < 0 || burstTime <= 0){
+			printf("Line %ld of the trace is not a valid process.\n", stream->lineNumber);
+			stream->error = 1;
+			return NULL;
+		}
+		stream->scratchRecord.processID = processID;
+		stream->scratchRecord.arrivalTime = arrivalTime;
+		stream->scratchRecord.burstTime = burstTime;
+		stream->scratchRecord.priority = priority;
+		return &stream->scratchRecord;
+	}
+	return NULL;
+}
+
+void closeTraceStream(struct TraceStream *stream){
+#ifndef _WIN32
+	if(stream->mappedBase != NULL){
+		munmap(stream->mappedBase, stream->mappedLength);
+	}
+#endif
+	if(stream->file != NULL){
+		fclose(stream->file);
+	}
+	free(stream->chunk);
+	memset(stream, 0, sizeof(struct TraceStream));
+}
+
+// This function loads every process of a trace into the Job Queue, returning the number of processes or -1 if the trace is invalid
+int loadTrace(struct ProcessArena *arena, struct Process **JobQueue, const char *path){
+	struct TraceStream stream;
+	const struct TraceRecord *record;
+	int numberOfProcesses = 0;
+	
+	if(!openTraceStream(&stream, path)){
+		return -1;
+	}
+	while((record = nextTraceRecord(&stream)) != NULL){
+		insertToJobQueue(arena, JobQueue, record->processID, record->arrivalTime, record->burstTime, (enum Priority)record->priority);
+		numberOfProcesses++;
+	}
+	if(stream.error){
+		numberOfProcesses = -1;
+	}
+	closeTraceStream(&stream);
+	return numberOfProcesses;
+}
+
+// This function writes the Job Queue as a binary trace, so that it can be memory-mapped the next time it is loaded
+int writeBinaryTrace(struct Process *JobQueue, const char *path){
+	struct TraceHeader header = {{'O', 'S', 'T', 'R'}, TRACE_VERSION, sizeof(struct TraceRecord), 0};
+	struct TraceRecord record;
+	struct Process *currentPtr = JobQueue;
+	FILE *file = fopen(path, "wb");
+	
+	if(file == NULL){
+		printf("Trace %s cannot be created.\n", path);
+		return 0;
+	}
+	fwrite(&header, sizeof(struct TraceHeader), 1, file);
+	while(currentPtr != NULL){
+		record.processID = currentPtr->processID;
+		record.arrivalTime = currentPtr->originalArrivalTime;
+		record.burstTime = currentPtr->burstTime;
+		record.priority = currentPtr->priority;
+		fwrite(&record, sizeof(struct TraceRecord), 1, file);
+		currentPtr = currentPtr->nextPtr;
+	}
+	if(fclose(file) != 0){
+		printf("Trace %s cannot be written.\n", path);
+		return 0;
+	}
+	return 1;
+}
+
+// This function runs Round Robin (or First Come First Serve if timeQuantum is 0) while reading the trace
+// Processes are only created once they arrive, and finished processes are reused for later arrivals
+// Hence, memory only depends on how many processes are waiting at the same time, not on the length of the trace
+// Returns 0 if the trace could not be fully read
+int streamScheduling(const char *path, int timeQuantum){
+	struct TraceStream stream;
+	struct ProcessArena streamArena; // Processes of the stream are allocated here, then reused through FreeList
+	struct ReadyRing ReadyQueue; // Trace is sorted by arrival time, so both FCFS and Round Robin are first-in first-out
+	struct Process *FreeList = NULL; // Finished processes waiting to be reused
+	const struct TraceRecord *nextRecord;
+	struct SchedulingResult result = {0, 0, 0, 0, 0, 0}; // Only totals are kept, since finished processes are reused
+	struct LatencyStatistics statistics; // Percentiles are kept in fixed-size histograms instead of per-process records
+	int currentTime = 0;
+	int previousArrivalTime = 0;
+	int roundRobin = 0;
+	
+	if(timeQuantum > 0){
+		outputSummary("\n\nProceeding to Round Robin Scheduling of streamed trace...\n\n");
+	}
+	else{
+		outputSummary("\n\nProceeding to First Come First Serve Algorithm of streamed trace...\n\n");
+	}
+	if(!openTraceStream(&stream, path)){
+		return 0;
+	}
+	if(!initReadyRing(&ReadyQueue, 64)){ // Without the Ready Queue nothing can run, so the trace is not read
+		closeTraceStream(&stream);
+		return 0;
+	}
+	initProcessArena(&streamArena);
+	initLatencyStatistics(&statistics);
+	nextRecord = nextTraceRecord(&stream);
+	
+	while(nextRecord != NULL || ReadyQueue.size > 0){
+		result.numberOfEvents++;
+		while(nextRecord != NULL && nextRecord->arrivalTime <= currentTime){ // Same as longTermScheduler, but processes come from the stream
+			struct Process *newPtr;
+			if(nextRecord->arrivalTime < previousArrivalTime){
+				printf("Trace must be sorted by arrival time to be streamed.\n");
+				stream.error = 1;
+				break;
+			}
+			previousArrivalTime = nextRecord->arrivalTime;
+			newPtr = admitTraceRecord(&streamArena, &FreeList, nextRecord); // Reuse a finished process if there is one
+			if(newPtr == NULL){
+				stream.error = 1;
+				break;
+			}
+			pushToRing(&ReadyQueue, newPtr);
+			nextRecord = nextTraceRecord(&stream);
+		}
+		if(stream.error){
+			break;
+		}
+		if(roundRobin == 1){ // Same rotation as roundRobinScheduling
+			rotateRing(&ReadyQueue);
+		}
+		if(ReadyQueue.size > 0){
+			struct Process *runningProcess = peekRing(&ReadyQueue);
+			int sliceLength = (timeQuantum > 0) ? roundRobinSliceLength(runningProcess->remainingTime, ReadyQueue.size, currentTime,
+				(nextRecord != NULL) ? nextRecord->arrivalTime : -1, timeQuantum) : runningProcess->remainingTime;
+			recordFirstRun(runningProcess, currentTime);
+			if(runningProcess->remainingTime <= sliceLength){ // Process finishes, so its results are added to the totals
+				currentTime += runningProcess->remainingTime;
+				recordLatencies(&statistics, runningProcess, currentTime);
+				popFromRing(&ReadyQueue);
+				runningProcess->nextPtr = FreeList; // Then the process is kept for reuse instead of being stored
+				FreeList = runningProcess;
+				roundRobin = 0;
+			}
+			else{
+				currentTime += sliceLength;
+				runningProcess->remainingTime -= sliceLength;
+				roundRobin = 1;
+			}
+		}
+		else{
+			currentTime = nextRecord->arrivalTime; // Nothing to execute, so jump straight to the next arrival
+		}
+	}
+	copyStatisticsToResult(&statistics, &result);
+	if(!stream.error && result.numberOfProcesses > 0){
+		result.totalCompletionTime = currentTime;
+		outputSummary("Processes executed: %ld\n", result.numberOfProcesses);
+		printAveragesHeader();
+		printAverages(&result);
+		printLatencyStatistics(&statistics);
+	}
+	freeReadyRing(&ReadyQueue);
+	freeProcessArena(&streamArena);
+	int succeeded = !stream.error; // Read before closing, since closing clears the stream
+	closeTraceStream(&stream);
+	return succeeded;
+}
+
+// This function turns a trace record into a process, reusing a finished process from FreeList if there is one
+// Returns NULL if there is no more memory
+struct Process *admitTraceRecord(struct ProcessArena *arena, struct Process **FreeList, const struct TraceRecord *record){
+	struct Process *newPtr;
+	if(*FreeList != NULL){
+		newPtr = *FreeList;
+		*FreeList = newPtr->nextPtr;
+	}
+	else{
+		newPtr = allocateProcess(arena);
+		if(newPtr == NULL){
+			printf("Process %d is not inserted as there is no more memory.\n", record->processID);
+			return NULL;
+		}
+	}
+	newPtr->processID = record->processID;
+	newPtr->arrivalTime = record->arrivalTime;
+	newPtr->originalArrivalTime = record->arrivalTime;
+	newPtr->burstTime = record->burstTime;
+	newPtr->priority = (enum Priority)record->priority;
+	newPtr->remainingTime = record->burstTime;
+	newPtr->heapIndex = -1;
+	newPtr->firstRunTime = -1;
+	newPtr->nextPtr = NULL;
+	return newPtr;
+}
+
+// This function runs every algorithm on the trace given in the command line, returning the exit code of the program
+int runTrace(struct ProcessArena *arena){
+	struct Process *JobQueue = NULL;
+	int numberOfProcesses;
+	
+	if(simulationOptions.streamTrace){ // A stream can only be read once, so each algorithm reads the trace again
+		int succeeded = streamScheduling(simulationOptions.tracePath, 0);
+		succeeded = streamScheduling(simulationOptions.tracePath, simulationOptions.timeQuantum) && succeeded;
+		return succeeded ? 0 : 1;
+	}
+	numberOfProcesses = loadTrace(arena, &JobQueue, simulationOptions.tracePath);
+	if(numberOfProcesses < 0){
+		clearProcesses(arena, &JobQueue);
+		return 1;
+	}
+	if(simulationOptions.binaryTracePath != NULL){
+		int written = writeBinaryTrace(JobQueue, simulationOptions.binaryTracePath);
+		clearProcesses(arena, &JobQueue);
+		return written ? 0 : 1;
+	}
+	outputSummary("\nTRACE %s (%d processes): \n", simulationOptions.tracePath, numberOfProcesses);
+	
+	runEveryAlgorithm(&JobQueue, numberOfProcesses, simulationOptions.timeQuantum);
+	
+	clearProcesses(arena, &JobQueue);
+	return 0;
+}
+
+// END OF TRACE FUNCTIONS
+// START OF OUTPUT FUNCTIONS
+
+// Every report of the algorithms goes through these functions, so that the output mode decides what is printed
+// outputText is for details (Gantt Chart header, Table of Processes), outputSummary is for averages and the headers naming them
+
+// This function prepares the buffer or the Gantt Chart file needed by the output mode, returning 0 if it cannot
+int initOutput(void){
+	if(simulationOptions.outputMode == BUFFEREDOUTPUT){
+		outputState.buffer = malloc(OUTPUT_BUFFER_SIZE);
+		if(outputState.buffer == NULL){
+			printf("Output buffer cannot be created as there is no more memory.\n");
+			return 0;
+		}
+	}
+	else if(simulationOptions.outputMode == BINARYOUTPUT){
+		outputState.ganttFile = fopen(simulationOptions.ganttPath, "wb");
+		if(outputState.ganttFile == NULL){
+			printf("Gantt Chart file %s cannot be created.\n", simulationOptions.ganttPath);
+			return 0;
+		}
+	}
+	return 1;
+}
+
+void closeOutput(void){
+	flushOutput();
+	free(outputState.buffer);
+	outputState.buffer = NULL;
+	if(outputState.ganttFile != NULL){
+		outputGanttEnd(); // In case an algorithm was interrupted
+		fclose(outputState.ganttFile);
+		outputState.ganttFile = NULL;
+	}
+}
+
+void flushOutput(void){ // Writes buffered text to stdout as one chunk
+	if(outputState.bufferUsed > 0){
+		fwrite(outputState.buffer, 1, outputState.bufferUsed, stdout);
+		outputState.bufferUsed = 0;
+	}
+	fflush(stdout);
+}
+
+// This function formats text to stdout, or into the buffer in BUFFEREDOUTPUT
+void writeOutput(const char *format, va_list arguments){
+	if(simulationOptions.outputMode != BUFFEREDOUTPUT){
+		vprintf(format, arguments);
+		return;
+	}
+	va_list copiedArguments;
+	va_copy(copiedArguments, arguments); // Arguments may be needed twice if text does not fit
+	int length = vsnprintf(outputState.buffer + outputState.bufferUsed, OUTPUT_BUFFER_SIZE - outputState.bufferUsed, format, arguments);
+	if(length >= 0 && (size_t)length >= OUTPUT_BUFFER_SIZE - outputState.bufferUsed){ // Text did not fit, so write the buffer out and try again
+		flushOutput();
+		length = vsnprintf(outputState.buffer, OUTPUT_BUFFER_SIZE, format, copiedArguments);
+		if(length >= OUTPUT_BUFFER_SIZE){ // Text is larger than the whole buffer, so only this text is truncated
+			length = OUTPUT_BUFFER_SIZE - 1;
+		}
+	}
+	if(length > 0){
+		outputState.bufferUsed += length;
+	}
+	va_end(copiedArguments);
+}
+
+void appendOutput(const char *text, size_t length){ // Copies text into the buffer without formatting it
+	if(outputState.bufferUsed + length > OUTPUT_BUFFER_SIZE){
+		flushOutput();
+	}
+	memcpy(outputState.buffer + outputState.bufferUsed, text, length);
+	outputState.bufferUsed += length;
+}
+
+void appendInteger(int value){ // Converts an integer to text directly into the buffer, which is much cheaper than printf
+	char digits[12];
+	int position = sizeof(digits);
+	unsigned int magnitude = (value < 0) ? 0u - (unsigned int)value : (unsigned int)value;
+	do{
+		digits[--position] = '0' + magnitude % 10;
+		magnitude /= 10;
+	}while(magnitude > 0);
+	if(value < 0){
+		digits[--position] = '-';
+	}
+	appendOutput(digits + position, sizeof(digits) - position);
+}
+
+void outputText(const char *format, ...){
+	va_list arguments;
+	if(simulationOptions.outputMode != TEXTOUTPUT && simulationOptions.outputMode != BUFFEREDOUTPUT){
+		return;
+	}
+	va_start(arguments, format);
+	writeOutput(format, arguments);
+	va_end(arguments);
+}
+
+void outputSummary(const char *format, ...){
+	va_list arguments;
+	if(simulationOptions.outputMode == SILENTOUTPUT){
+		return;
+	}
+	va_start(arguments, format);
+	writeOutput(format, arguments);
+	va_end(arguments);
+}
+
+// This function prints one box of the Gantt Chart, where runningProcess is NULL if CPU was idle
+void outputGanttSlice(int startTime, int endTime, struct Process *runningProcess){
+	char label[16];
+	int processID = (runningProcess != NULL) ? runningProcess->processID : 0;
+	
+	if(simulationOptions.outputMode == TEXTOUTPUT){
+		getProcessLabel(label, processID);
+		printf("[%d %s %d]", startTime, label, endTime);
+	}
+	else if(simulationOptions.outputMode == BUFFEREDOUTPUT){
+		getProcessLabel(label, processID);
+		appendOutput("[", 1);
+		appendInteger(startTime);
+		appendOutput(" ", 1);
+		appendOutput(label, strlen(label));
+		appendOutput(" ", 1);
+		appendInteger(endTime);
+		appendOutput("]", 1);
+	}
+	else if(simulationOptions.outputMode == BINARYOUTPUT){
+		if(outputState.hasPendingSlice && outputState.pendingSlice.processID == processID && outputState.pendingSlice.endTime == startTime){
+			outputState.pendingSlice.endTime = endTime; // Same process continues right away, so both boxes become one record
+			return;
+		}
+		if(outputState.hasPendingSlice){
+			fwrite(&outputState.pendingSlice, sizeof(struct GanttRecord), 1, outputState.ganttFile);
+		}
+		outputState.pendingSlice.startTime = startTime;
+		outputState.pendingSlice.endTime = endTime;
+		outputState.pendingSlice.processID = processID;
+		outputState.hasPendingSlice = 1;
+	}
+}
+
+void outputGanttEnd(void){ // Called once an algorithm ends, so that its Gantt Chart is separated from the next one
+	struct GanttRecord endRecord = {-1, -1, -1};
+	if(simulationOptions.outputMode != BINARYOUTPUT || outputState.ganttFile == NULL){
+		return;
+	}
+	if(outputState.hasPendingSlice){
+		fwrite(&outputState.pendingSlice, sizeof(struct GanttRecord), 1, outputState.ganttFile);
+		outputState.hasPendingSlice = 0;
+	}
+	fwrite(&endRecord, sizeof(struct GanttRecord), 1, outputState.ganttFile);
+}
+
+// This function gives the label of a process in the Gantt Chart: A to Z for processes 1 to 26, P followed by the number otherwise, and __ if idle
+void getProcessLabel(char *label, int processID){
+	if(processID == 0){
+		strcpy(label, "__");
+	}
+	else if(processID >= 1 && processID <= 26){
+		label[0] = (char)(processID + 64);
+		label[1] = '\0';
+	}
+	else{
+		sprintf(label, "P%d", processID);
+	}
+}
+
+// END OF OUTPUT FUNCTIONS
+// START OF SWEEP FUNCTIONS
+
+// The sweep runs every algorithm, and round robin with every time quantum in a range, on the same trace at the same time
+// The trace is loaded once into an array that workers only read
+// Each worker builds its own copy of the processes from that array before each run, since algorithms change processes while running
+
+// This function reads every record of a trace into one array, returning the number of processes or -1 if the trace is invalid
+int loadWorkload(const char *path, struct TraceRecord **workload){
+	struct TraceStream stream;
+	const struct TraceRecord *record;
+	int numberOfProcesses = 0;
+	int capacity = 1024;
+	
+	*workload = malloc(capacity * sizeof(struct TraceRecord));
+	if(*workload == NULL || !openTraceStream(&stream, path)){
+		free(*workload);
+		*workload = NULL;
+		return -1;
+	}
+	while((record = nextTraceRecord(&stream)) != NULL){
+		if(numberOfProcesses == capacity){ // If array is full, we double its capacity
+			struct TraceRecord *newWorkload = realloc(*workload, capacity * 2 * sizeof(struct TraceRecord));
+			if(newWorkload == NULL){
+				printf("Trace %s cannot be loaded as there is no more memory.\n", path);
+				stream.error = 1;
+				break;
+			}
+			*workload = newWorkload;
+			capacity *= 2;
+		}
+		(*workload)[numberOfProcesses++] = *record;
+	}
+	if(stream.error){
+		free(*workload);
+		*workload = NULL;
+		numberOfProcesses = -1;
+	}
+	closeTraceStream(&stream);
+	return numberOfProcesses;
+}
+
+// This function creates a private Job Queue from the shared workload
+void buildJobQueue(struct ProcessArena *arena, struct Process **JobQueue, const struct TraceRecord *workload, int numberOfProcesses){
+	int loopVar;
+	clearProcesses(arena, JobQueue); // Blocks of the previous run are reused
+	for(loopVar = 0; loopVar < numberOfProcesses; loopVar++){
+		insertToJobQueue(arena, JobQueue, workload[loopVar].processID, workload[loopVar].arrivalTime, workload[loopVar].burstTime, (enum Priority)workload[loopVar].priority);
+	}
+}
+
+// Each worker takes the next configuration not yet taken, runs it on its own copy of the processes, then stores the result in the configuration
+void *sweepWorker(void *arg){
+	struct SweepPool *pool = (struct SweepPool *)arg;
+	struct ProcessArena workerArena; // Private to this worker
+	struct Process *JobQueue = NULL;
+	
+	initProcessArena(&workerArena);
+	while(1){
+		pthread_mutex_lock(&pool->mutexToTakeConfiguration);
+		int configurationIndex = pool->nextConfiguration++;
+		pthread_mutex_unlock(&pool->mutexToTakeConfiguration);
+		if(configurationIndex >= pool->numberOfConfigurations){ // Every configuration has been taken
+			break;
+		}
+		struct SweepConfiguration *configuration = &pool->configurations[configurationIndex];
+		buildJobQueue(&workerArena, &JobQueue, pool->workload, pool->numberOfProcesses);
+		configuration->result = runAlgorithm(configuration->algorithm, &JobQueue, pool->numberOfProcesses, configuration->timeQuantum);
+	}
+	clearProcesses(&workerArena, &JobQueue);
+	freeProcessArena(&workerArena);
+	return NULL;
+}
+
+// This function runs the sweep given in the command line, then prints one table comparing every configuration
+int runSweep(void){
+	struct SweepPool pool;
+	struct TraceRecord *workload = NULL;
+	pthread_t *workers;
+	int numberOfThreads = simulationOptions.numberOfThreads;
+	int numberOfQuantums = simulationOptions.sweepMaximumQuantum - simulationOptions.sweepMinimumQuantum + 1;
+	enum SchedulingAlgorithm quantumAlgorithms[] = {ROUNDROBIN, ROUNDROBINNOIDLE, MLFQ, CFS}; // MLFQ scales its levels and CFS its latency from the quantum
+	int numberOfQuantumAlgorithms = 4;
+	int loopVar;
+	
+	pool.numberOfProcesses = loadWorkload(simulationOptions.tracePath, &workload);
+	if(pool.numberOfProcesses < 0){
+		return 1;
+	}
+	pool.workload = workload;
+	pool.numberOfConfigurations = 5 + numberOfQuantumAlgorithms * numberOfQuantums; // Algorithms without a quantum are run once
+	pool.configurations = malloc(pool.numberOfConfigurations * sizeof(struct SweepConfiguration));
+	pool.nextConfiguration = 0;
+	if(numberOfThreads == 0){
+#ifdef _SC_NPROCESSORS_ONLN
+		numberOfThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+		if(numberOfThreads <= 0){
+			numberOfThreads = 4;
+		}
+	}
+	if(numberOfThreads > pool.numberOfConfigurations){ // Extra workers would have nothing to do
+		numberOfThreads = pool.numberOfConfigurations;
+	}
+	workers = malloc(numberOfThreads * sizeof(pthread_t));
+	if(pool.configurations == NULL || workers == NULL){
+		printf("Sweep cannot be started as there is no more memory.\n");
+		free(pool.configurations);
+		free(workers);
+		free(workload);
+		return 1;
+	}
+	pool.configurations[0].algorithm = FCFS; // Algorithms without a quantum are listed first
+	pool.configurations[1].algorithm = FCFSNOIDLE;
+	pool.configurations[2].algorithm = SJF;
+	pool.configurations[3].algorithm = SRTF;
+	pool.configurations[4].algorithm = PRIORITY;
+	for(loopVar = 0; loopVar < 5; loopVar++){
+		pool.configurations[loopVar].timeQuantum = 0;
+	}
+	for(loopVar = 0; loopVar < numberOfQuantums * numberOfQuantumAlgorithms; loopVar++){ // Every algorithm with a quantum is run with each quantum, listed by quantum
+		pool.configurations[5 + loopVar].algorithm = quantumAlgorithms[loopVar % numberOfQuantumAlgorithms];
+		pool.configurations[5 + loopVar].timeQuantum = simulationOptions.sweepMinimumQuantum + loopVar / numberOfQuantumAlgorithms;
+	}
+	pthread_mutex_init(&pool.mutexToTakeConfiguration, NULL);
+	
+	enum OutputMode outputMode = simulationOptions.outputMode;
+	simulationOptions.outputMode = SILENTOUTPUT; // Workers must not print, since their output would be mixed together
+	int startedThreads = 0;
+	for(loopVar = 0; loopVar < numberOfThreads; loopVar++){
+		if(pthread_create(&workers[loopVar], NULL, sweepWorker, (void *)&pool) != 0){ // Workers already started take every configuration, so the sweep goes on with fewer of them
+			break;
+		}
+		startedThreads++;
+	}
+	if(startedThreads == 0){ // No worker could be started, so the configurations are run by this thread instead
+		sweepWorker((void *)&pool);
+	}
+	for(loopVar = 0; loopVar < startedThreads; loopVar++){
+		pthread_join(workers[loopVar], NULL);
+	}
+	numberOfThreads = (startedThreads > 0) ? startedThreads : 1;
+	simulationOptions.outputMode = outputMode;
+	
+	printf("\nSWEEP %s (%d processes, %d configurations, %d workers): \n", simulationOptions.tracePath, pool.numberOfProcesses, pool.numberOfConfigurations, numberOfThreads);
+	printf("%-22s| %-8s| %-21s| %-20s| %-20s| %-10s|\n", "Algorithm", "Quantum", "Total Completion Time", "Avg Turnaround Time", "Avg Waiting Time", "Throughput");
+	printf("---------------------------------------------------------------------------------------------------------------------\n");
+	for(loopVar = 0; loopVar < pool.numberOfConfigurations; loopVar++){
+		struct SweepConfiguration *configuration = &pool.configurations[loopVar];
+		double numberOfProcesses = configuration->result.numberOfProcesses;
+		printf("%-22s| ", algorithmNames[configuration->algorithm]);
+		if(configuration->timeQuantum > 0){
+			printf("%-8d| ", configuration->timeQuantum);
+		}
+		else{
+			printf("%-8s| ", "-");
+		}
+		printf("%-21d| %-20.3f| %-20.3f| %-10.3f|\n", configuration->result.totalCompletionTime,
+			configuration->result.totalTurnaroundTime / numberOfProcesses, configuration->result.totalWaitingTime / numberOfProcesses,
+			numberOfProcesses / configuration->result.totalCompletionTime);
+	}
+	
+	pthread_mutex_destroy(&pool.mutexToTakeConfiguration);
+	free(pool.configurations);
+	free(workers);
+	free(workload);
+	return 0;
+}
+
+// END OF SWEEP FUNCTIONS
+// START OF AUTOTUNE FUNCTIONS
+
+// The autotuner runs Round Robin (with idle times) with every time quantum in a range and picks the best one for an objective
+// Candidates are not run one by one from time 0: a group of candidates shares one run for as long as their slices are the same
+// Before each slice, the slice of every candidate of the group is found the same way as roundRobinSliceLength finds it
+// They are the same if the process finishes within every quantum, or runs alone to the same point with every quantum
+// Otherwise the group splits by slice length, and the state is copied for each new group, which later resumes from that point
+// The state is only the processes in the Ready Queue, so copying it costs O(waiting processes) instead of restarting the trace
+// Groups split the first time a process needs more than a quantum while others wait, so under load most sharing is near the start
+
+// This function runs the autotune given in the command line, returning the exit code of the program
+int runAutotune(void){
+	struct TraceRecord *workload = NULL;
+	struct ProcessArena arena;
+	struct Process *JobQueue = NULL;
+	struct Process *currentPtr;
+	struct TuningState *states; // states[group] is the run shared by the candidates of that group
+	struct TuningGroup *groups;
+	struct TuningCandidate *candidates;
+	int *arrivalTime, *burstTime;
+	int *order; // Candidates ordered so that every group is a range of this array, with quantums increasing inside it
+	int *sliceOfEntry; // Slice of each candidate of a group that is being compared
+	int *pendingGroups; // Groups that split off and wait to resume from their copy of the state
+	int numberOfCandidates = simulationOptions.autotuneMaximumQuantum - simulationOptions.autotuneMinimumQuantum + 1;
+	int numberOfProcesses, loopVar, bestCandidate;
+	int numberOfGroups = 1, numberOfPendingGroups = 1;
+	int failed = 0;
+	long long simulatedSlices = 0, unsharedSlices = 0;
+	
+	numberOfProcesses = loadWorkload(simulationOptions.tracePath, &workload);
+	if(numberOfProcesses < 0){
+		return 1;
+	}
+	arrivalTime = malloc((numberOfProcesses + 1) * sizeof(int));
+	burstTime = malloc((numberOfProcesses + 1) * sizeof(int));
+	candidates = malloc(numberOfCandidates * sizeof(struct TuningCandidate));
+	states = calloc(numberOfCandidates, sizeof(struct TuningState)); // There are never more groups than candidates
+	groups = malloc(numberOfCandidates * sizeof(struct TuningGroup));
+	order = malloc(numberOfCandidates * sizeof(int));
+	sliceOfEntry = malloc(numberOfCandidates * sizeof(int));
+	pendingGroups = malloc(numberOfCandidates * sizeof(int));
+	if(arrivalTime == NULL || burstTime == NULL || candidates == NULL || states == NULL || groups == NULL || order == NULL
+	|| sliceOfEntry == NULL || pendingGroups == NULL || !initTuningState(&states[0])){
+		printf("Autotune cannot be started as there is no more memory.\n");
+		if(states != NULL){
+			freeTuningState(&states[0]);
+		}
+		free(arrivalTime);
+		free(burstTime);
+		free(candidates);
+		free(states);
+		free(groups);
+		free(order);
+		free(sliceOfEntry);
+		free(pendingGroups);
+		free(workload);
+		return 1;
+	}
+	initProcessArena(&arena);
+	buildJobQueue(&arena, &JobQueue, workload, numberOfProcesses);
+	sortJobQueueByArrival(&JobQueue); // Same order as roundRobinScheduling admits the processes
+	for(currentPtr = JobQueue, loopVar = 0; currentPtr != NULL; currentPtr = currentPtr->nextPtr, loopVar++){
+		arrivalTime[loopVar] = currentPtr->arrivalTime;
+		burstTime[loopVar] = currentPtr->burstTime;
+	}
+	clearProcesses(&arena, &JobQueue);
+	freeProcessArena(&arena);
+	free(workload);
+	for(loopVar = 0; loopVar < numberOfCandidates; loopVar++){
+		candidates[loopVar].timeQuantum = simulationOptions.autotuneMinimumQuantum + loopVar;
+		order[loopVar] = loopVar;
+	}
+	groups[0].firstEntry = 0; // At first every candidate shares one run from time 0
+	groups[0].lastEntry = numberOfCandidates - 1;
+	pendingGroups[0] = 0;
+	
+	while(numberOfPendingGroups > 0 && !failed){
+		int group = pendingGroups[--numberOfPendingGroups];
+		struct TuningState *state = &states[group];
+		while((state->nextArrival < numberOfProcesses || state->ringSize > 0) && !failed){
+			struct TuningEntry *runningEntry;
+			int sliceLength;
+			int firstEntry = groups[group].firstEntry;
+			int lastEntry = groups[group].lastEntry;
+			while(state->nextArrival < numberOfProcesses && arrivalTime[state->nextArrival] <= state->currentTime){ // Same as longTermSchedulerToRing
+				failed = !pushToTuningRing(state, state->nextArrival, burstTime[state->nextArrival]) || failed;
+				state->nextArrival++;
+			}
+			if(state->roundRobin == 1){ // Same rotation as roundRobinScheduling
+				failed = !pushToTuningRing(state, state->ring[state->ringHead].process, state->ring[state->ringHead].remainingTime) || failed;
+				popFromTuningRing(state);
+				state->roundRobin = 0;
+			}
+			if(state->ringSize == 0){ // Nothing to execute, so jump straight to the next arrival
+				state->currentTime = arrivalTime[state->nextArrival];
+				continue;
+			}
+			runningEntry = &state->ring[state->ringHead];
+			int nextArrivalTime = (state->nextArrival < numberOfProcesses) ? arrivalTime[state->nextArrival] : -1;
+			if(firstEntry < lastEntry && runningEntry->remainingTime > candidates[order[firstEntry]].timeQuantum){ // Smallest quantum of the group may not finish the process, so the slices are compared
+				for(loopVar = firstEntry; loopVar <= lastEntry; loopVar++){
+					sliceLength = roundRobinSliceLength(runningEntry->remainingTime, state->ringSize, state->currentTime, nextArrivalTime,
+						candidates[order[loopVar]].timeQuantum);
+					sliceOfEntry[loopVar] = (sliceLength < runningEntry->remainingTime) ? sliceLength : runningEntry->remainingTime; // Every slice that finishes the process has the same effect
+				}
+				for(loopVar = firstEntry + 1; loopVar <= lastEntry; loopVar++){ // Insertion sort by slice, which keeps quantums increasing inside each run of equal slices
+					int candidate = order[loopVar];
+					int slice = sliceOfEntry[loopVar];
+					int insertEntry = loopVar;
+					while(insertEntry > firstEntry && sliceOfEntry[insertEntry - 1] > slice){
+						order[insertEntry] = order[insertEntry - 1];
+						sliceOfEntry[insertEntry] = sliceOfEntry[insertEntry - 1];
+						insertEntry--;
+					}
+					order[insertEntry] = candidate;
+					sliceOfEntry[insertEntry] = slice;
+				}
+				int splitEntry = lastEntry; // Last entry of the run of equal slices that becomes the next group
+				for(loopVar = lastEntry; loopVar > firstEntry && !failed; loopVar--){
+					if(sliceOfEntry[loopVar - 1] != sliceOfEntry[loopVar]){ // Entries loopVar to splitEntry split off, resuming later from a copy of the state
+						groups[numberOfGroups].firstEntry = loopVar;
+						groups[numberOfGroups].lastEntry = splitEntry;
+						failed = !copyTuningState(&states[numberOfGroups], state);
+						pendingGroups[numberOfPendingGroups++] = numberOfGroups++;
+						splitEntry = loopVar - 1;
+					}
+				}
+				groups[group].lastEntry = splitEntry; // This group goes on with the smallest slice
+				if(failed){
+					break;
+				}
+			}
+			sliceLength = roundRobinSliceLength(runningEntry->remainingTime, state->ringSize, state->currentTime, nextArrivalTime,
+				candidates[order[firstEntry]].timeQuantum); // Every candidate left in the group has this slice
+			simulatedSlices++;
+			state->slices++;
+			if(runningEntry->process != state->lastProcess){
+				state->contextSwitches++;
+				state->lastProcess = runningEntry->process;
+			}
+			if(runningEntry->remainingTime <= sliceLength){ // Process finishes
+				int turnaroundTime;
+				state->currentTime += runningEntry->remainingTime;
+				turnaroundTime = state->currentTime - arrivalTime[runningEntry->process];
+				state->totalTurnaroundTime += turnaroundTime;
+				state->totalWaitingTime += turnaroundTime - burstTime[runningEntry->process];
+				addToStatistic(&state->turnaroundTime, turnaroundTime);
+				popFromTuningRing(state);
+			}
+			else{
+				state->currentTime += sliceLength;
+				runningEntry->remainingTime -= sliceLength;
+				state->roundRobin = 1;
+			}
+		}
+		for(loopVar = groups[group].firstEntry; loopVar <= groups[group].lastEntry && !failed; loopVar++){ // Every candidate of the group had the same schedule
+			struct TuningCandidate *candidate = &candidates[order[loopVar]];
+			candidate->totalCompletionTime = state->currentTime;
+			candidate->averageWaitingTime = (numberOfProcesses > 0) ? (double)state->totalWaitingTime / numberOfProcesses : 0.0;
+			candidate->averageTurnaroundTime = (numberOfProcesses > 0) ? (double)state->totalTurnaroundTime / numberOfProcesses : 0.0;
+			candidate->percentile99TurnaroundTime = statisticPercentile(&state->turnaroundTime, 0.99);
+			candidate->contextSwitches = state->contextSwitches;
+			unsharedSlices += state->slices;
+		}
+		freeTuningState(state); // Finished groups give back their Ready Queue, so only waiting groups hold memory
+	}
+	
+	if(failed){
+		printf("Autotune cannot be finished as there is no more memory.\n");
+	}
+	else{
+		bestCandidate = 0;
+		for(loopVar = 1; loopVar < numberOfCandidates; loopVar++){ // Ties go to the smallest quantum
+			if(tuningObjectiveValue(&candidates[loopVar]) < tuningObjectiveValue(&candidates[bestCandidate])){
+				bestCandidate = loopVar;
+			}
+		}
+		printf("\nAUTOTUNE %s (%d processes, %d quantums, objective %s): \n", simulationOptions.tracePath, numberOfProcesses, numberOfCandidates,
+			objectiveNames[simulationOptions.tuningObjective]);
+		printf("%-8s| %-21s| %-20s| %-20s| %-20s| %-17s|\n", "Quantum", "Total Completion Time", "Avg Turnaround Time", "Avg Waiting Time", "p99 Turnaround Time", "Context Switches");
+		printf("---------------------------------------------------------------------------------------------------------------------\n");
+		for(loopVar = 0; loopVar < numberOfCandidates; loopVar++){
+			printf("%-8d| %-21d| %-20.3f| %-20.3f| %-20d| %-17ld|\n", candidates[loopVar].timeQuantum, candidates[loopVar].totalCompletionTime,
+				candidates[loopVar].averageTurnaroundTime, candidates[loopVar].averageWaitingTime,
+				candidates[loopVar].percentile99TurnaroundTime, candidates[loopVar].contextSwitches);
+		}
+		printf("\nBest quantum for %s: %d\n", objectiveNames[simulationOptions.tuningObjective], candidates[bestCandidate].timeQuantum);
+		printf("Slices simulated: %lld (%lld if every quantum had been run from time 0)\n", simulatedSlices, unsharedSlices);
+	}
+	
+	for(loopVar = 0; loopVar < numberOfGroups; loopVar++){ // Groups left waiting if memory ran out
+		freeTuningState(&states[loopVar]);
+	}
+	free(arrivalTime);
+	free(burstTime);
+	free(candidates);
+	free(states);
+	free(groups);
+	free(order);
+	free(sliceOfEntry);
+	free(pendingGroups);
+	return failed;
+}
+
+// This function returns the value the objective minimizes
+double tuningObjectiveValue(struct TuningCandidate *candidate){
+	if(simulationOptions.tuningObjective == P99TURNAROUNDOBJECTIVE){
+		return candidate->percentile99TurnaroundTime;
 	}
-	averageTurnaroundTime = totalTurnaroundTime / numberOfProcesses; // Calculate avg, note numberofProcesses has been casted to double to allow decimal division
-	averageWaitingTime = totalWaitingTime / numberOfProcesses;
-	throughput = numberOfProcesses / totalCompletionTime;
-    printf("%-21d| %-20.3f| %-20.3f| %-10.3f|\n", // Print the information
-           totalCompletionTime, averageTurnaroundTime, averageWaitingTime, throughput);
+	else if(simulationOptions.tuningObjective == CONTEXTSWITCHOBJECTIVE){
+		return candidate->contextSwitches;
+	}
+	return candidate->averageWaitingTime;
 }
 
-// END OF DATA FUNCTIONS
+int initTuningState(struct TuningState *state){ // Returns 0 if there is no memory
+	state->ringCapacity = TUNING_RING_CAPACITY; // Ready Queue grows when it is full
+	state->ring = malloc(state->ringCapacity * sizeof(struct TuningEntry));
+	state->ringHead = 0;
+	state->ringSize = 0;
+	state->nextArrival = 0;
+	state->currentTime = 0;
+	state->roundRobin = 0;
+	state->lastProcess = -1;
+	state->slices = 0;
+	state->totalTurnaroundTime = 0;
+	state->totalWaitingTime = 0;
+	state->contextSwitches = 0;
+	initOnlineStatistic(&state->turnaroundTime);
+	return state->ring != NULL;
+}
+
+void freeTuningState(struct TuningState *state){
+	free(state->ring);
+	state->ring = NULL;
+}
+
+// This function copies everything into a new ring that only holds the waiting processes, which start again from slot 0
+// Returns 0 if there is no memory
+int copyTuningState(struct TuningState *destination, struct TuningState *source){
+	int ringCapacity = (source->ringSize > TUNING_RING_CAPACITY) ? source->ringSize : TUNING_RING_CAPACITY;
+	struct TuningEntry *ring = malloc(ringCapacity * sizeof(struct TuningEntry));
+	int loopVar;
+	if(ring == NULL){
+		return 0;
+	}
+	*destination = *source;
+	destination->ring = ring;
+	destination->ringHead = 0;
+	destination->ringCapacity = ringCapacity;
+	for(loopVar = 0; loopVar < source->ringSize; loopVar++){
+		destination->ring[loopVar] = source->ring[(source->ringHead + loopVar) % source->ringCapacity];
+	}
+	return 1;
+}
+
+int pushToTuningRing(struct TuningState *state, int process, int remainingTime){ // Returns 0 if the ring is full and cannot grow
+	if(state->ringSize == state->ringCapacity){ // If ring is full, we double its capacity and unwrap it, so the front is at slot 0 again
+		struct TuningEntry *newRing = malloc(2 * state->ringCapacity * sizeof(struct TuningEntry));
+		int loopVar;
+		if(newRing == NULL){
+			return 0;
+		}
+		for(loopVar = 0; loopVar < state->ringSize; loopVar++){
+			newRing[loopVar] = state->ring[(state->ringHead + loopVar) % state->ringCapacity];
+		}
+		free(state->ring);
+		state->ring = newRing;
+		state->ringHead = 0;
+		state->ringCapacity *= 2;
+	}
+	struct TuningEntry *entry = &state->ring[(state->ringHead + state->ringSize) % state->ringCapacity];
+	entry->process = process;
+	entry->remainingTime = remainingTime;
+	state->ringSize++;
+	return 1;
+}
+
+void popFromTuningRing(struct TuningState *state){
+	state->ringHead = (state->ringHead + 1) % state->ringCapacity;
+	state->ringSize--;
+}
+
+// END OF AUTOTUNE FUNCTIONS
+// START OF MULTI-CORE FUNCTIONS
+
+// In multi-core mode every CPU has its own Run Queue (a Ready Heap), and arrivals are spread over them by the placement policy
+// Time jumps from one event to the next (an arrival, a completion or an expired time quantum), and every CPU is checked at each event
+// Hence, each event costs O(CPUs + log n), and no time is spent stepping through periods where nothing changes
+
+// This function runs FCFS, Round Robin, SJF, SRTF or Preemptive Priority on the CPUs given in the command line
+struct SchedulingResult multiCoreScheduling(enum SchedulingAlgorithm algorithm, struct Process **JobQueue, int numberOfProcesses, int timeQuantum){
+	int numberOfCpus = simulationOptions.numberOfCpus;
+	enum SortingMetric sortingMetric = LEASTARRIVALTIME;
+	int preemptive = 0; // If 1, a process placed on a CPU can preempt the running process of that CPU
+	struct CpuCore *cores;
+	struct ProcessTable table;
+	struct SchedulingResult result = {0, 0, 0, 0, 0, 0};
+	int currentTime = 0;
+	int nextEventTime = 0;
+	int nextCpu = 0; // CPU given the next arrival in round-robin placement
+	int loopVar;
+	
+	if(algorithm == SJF){
+		sortingMetric = LEASTBURSTTIME;
+	}
+	else if(algorithm == SRTF){
+		sortingMetric = LEASTREMAININGTIME;
+		preemptive = 1;
+	}
+	else if(algorithm == PRIORITY){
+		sortingMetric = HIGHESTPRIORITY;
+		preemptive = 1;
+	}
+	if(algorithm != ROUNDROBIN && algorithm != ROUNDROBINNOIDLE){ // Only Round Robin lets a time quantum expire
+		timeQuantum = 0;
+	}
+	outputSummary("\n\nProceeding to %s on %d CPUs (%s placement%s)...\n\n", algorithmNames[algorithm], numberOfCpus,
+		placementNames[simulationOptions.placementPolicy], simulationOptions.workStealing ? ", work stealing" : "");
+	cores = calloc(numberOfCpus, sizeof(struct CpuCore));
+	if(cores == NULL){ // If ever memory allocation fails, we notify.
+		printf("CPUs cannot be created as there is no more memory.\n");
+		return result;
+	}
+	int created = 1;
+	for(loopVar = 0; loopVar < numberOfCpus; loopVar++){
+		created = initReadyHeap(&cores[loopVar].RunQueue, sortingMetric, 16) && created; // Every Run Queue is initialized, so every one can be freed
+	}
+	if(!created || !initProcessTable(&table, *JobQueue, numberOfProcesses)){ // Without the Run Queues or the table the algorithm cannot run, so it stops
+		for(loopVar = 0; loopVar < numberOfCpus; loopVar++){
+			freeReadyHeap(&cores[loopVar].RunQueue);
+		}
+		free(cores);
+		return result;
+	}
+	sortJobQueueByArrival(JobQueue);
+	
+	long long numberOfEvents = 0;
+	while(1){
+		numberOfEvents++;
+		for(loopVar = 0; loopVar < numberOfCpus; loopVar++){ // Charge every running process for the time since the last event
+			struct CpuCore *core = &cores[loopVar];
+			if(core->runningProcess != NULL){
+				core->runningProcess->remainingTime -= currentTime - core->lastEventTime;
+				core->busyTime += currentTime - core->lastEventTime;
+				core->lastEventTime = currentTime;
+				if(core->runningProcess->remainingTime == 0){ // Finished processes free their CPU before arrivals are placed
+					terminateProcess(core->runningProcess, &table, currentTime);
+					core->runningProcess = NULL;
+					core->completions++;
+				}
+			}
+		}
+		while(*JobQueue != NULL && (*JobQueue)->arrivalTime <= currentTime){ // Same as longTermScheduler, but the placement policy chooses the Run Queue
+			struct Process *PtrToTransfer = *JobQueue;
+			*JobQueue = (*JobQueue)->nextPtr;
+			PtrToTransfer->nextPtr = NULL;
+			insertToHeap(&cores[placeProcess(cores, numberOfCpus, &nextCpu)].RunQueue, PtrToTransfer);
+		}
+		for(loopVar = 0; loopVar < numberOfCpus; loopVar++){
+			struct CpuCore *core = &cores[loopVar];
+			if(core->runningProcess == NULL){
+				continue;
+			}
+			if(timeQuantum > 0 && core->sliceEndTime == currentTime){ // Time quantum expired, so the process goes behind the arrivals, same as roundRobinScheduling
+				insertToHeapWithKey(&core->RunQueue, core->runningProcess, currentTime, currentTime);
+				core->runningProcess = NULL;
+			}
+			else if(preemptive && core->RunQueue.size > 0){
+				if(sortingMetric == LEASTREMAININGTIME){
+					core->runningEntry.primaryKey = core->runningProcess->remainingTime;
+				}
+				if(compareHeapEntries(&core->RunQueue.entries[0], &core->runningEntry) < 0){ // A waiting process goes first, so the running process is preempted
+					insertHeapEntry(&core->RunQueue, core->runningEntry);
+					core->runningProcess = NULL;
+				}
+			}
+		}
+		for(loopVar = 0; loopVar < numberOfCpus; loopVar++){ // Every free CPU executes the first process of its own Run Queue
+			if(cores[loopVar].runningProcess == NULL && cores[loopVar].RunQueue.size > 0){
+				dispatchProcess(&cores[loopVar], &cores[loopVar].RunQueue, currentTime, timeQuantum);
+			}
+		}
+		if(simulationOptions.workStealing){
+			for(loopVar = 0; loopVar < numberOfCpus; loopVar++){ // CPUs still free steal, until no Run Queue has a waiting process
+				if(cores[loopVar].runningProcess == NULL && !stealProcess(cores, numberOfCpus, loopVar, currentTime, timeQuantum)){
+					break;
+				}
+			}
+		}
+		nextEventTime = -1;
+		for(loopVar = 0; loopVar < numberOfCpus; loopVar++){ // Next event is the earliest completion or expiry of a running process...
+			if(cores[loopVar].runningProcess != NULL && (nextEventTime < 0 || cores[loopVar].sliceEndTime < nextEventTime)){
+				nextEventTime = cores[loopVar].sliceEndTime;
+			}
+		}
+		if(*JobQueue != NULL && (nextEventTime < 0 || (*JobQueue)->arrivalTime < nextEventTime)){ // ...or the next arrival, if it comes first
+			nextEventTime = (*JobQueue)->arrivalTime;
+		}
+		if(nextEventTime < 0){ // Nothing is running and nothing is left to arrive, so every process is finished
+			break;
+		}
+		currentTime = nextEventTime;
+	}
+	for(loopVar = 0; loopVar < numberOfCpus; loopVar++){
+		freeReadyHeap(&cores[loopVar].RunQueue);
+	}
+	*JobQueue = linkProcessesByID(&table);
+	computeProcessMetrics(&table);
+	copyMetricsToProcesses(&table);
+	printTable(*JobQueue);
+	printCoreTable(cores, numberOfCpus, currentTime);
+	printAveragesHeader();
+	result = summarizeProcessTable(&table, currentTime);
+	result.numberOfEvents = numberOfEvents;
+	printAverages(&result);
+	printLatencyStatistics(&table.statistics);
+	freeProcessTable(&table);
+	free(cores);
+	return result;
+}
+
+// This function returns the CPU whose Run Queue receives an arriving process, based on the placement policy
+int placeProcess(struct CpuCore *cores, int numberOfCpus, int *nextCpu){
+	int chosenCpu = 0;
+	int loopVar;
+	
+	if(simulationOptions.placementPolicy == ROUNDROBINPLACEMENT){
+		chosenCpu = *nextCpu;
+		*nextCpu = (*nextCpu + 1) % numberOfCpus;
+	}
+	else if(simulationOptions.placementPolicy == LEASTLOADEDPLACEMENT){ // Load is the number of processes waiting on or running on the CPU
+		int leastLoad = cores[0].RunQueue.size + (cores[0].runningProcess != NULL);
+		for(loopVar = 1; loopVar < numberOfCpus && leastLoad > 0; loopVar++){
+			int load = cores[loopVar].RunQueue.size + (cores[loopVar].runningProcess != NULL);
+			if(load < leastLoad){ // Ties go to the lower CPU
+				leastLoad = load;
+				chosenCpu = loopVar;
+			}
+		}
+	}
+	return chosenCpu;
+}
+
+// This function lets the CPU execute the first process of the given Run Queue, which is its own or the one it steals from
+void dispatchProcess(struct CpuCore *core, struct ReadyHeap *RunQueue, int currentTime, int timeQuantum){
+	core->runningEntry = RunQueue->entries[0]; // Entry is kept so that a preempted process rejoins in the same order
+	core->runningProcess = popFromHeap(RunQueue);
+	recordFirstRun(core->runningProcess, currentTime);
+	core->lastEventTime = currentTime;
+	core->sliceEndTime = currentTime + core->runningProcess->remainingTime; // Process runs until it finishes...
+	if(timeQuantum > 0 && core->runningProcess->remainingTime > timeQuantum){ // ...or until its time quantum expires
+		core->sliceEndTime = currentTime + timeQuantum;
+	}
+	core->dispatches++;
+}
+
+// This function lets a free CPU take the first waiting process of the longest Run Queue, returning 0 if no process is waiting anywhere
+int stealProcess(struct CpuCore *cores, int numberOfCpus, int thiefIndex, int currentTime, int timeQuantum){
+	int victimIndex = -1;
+	int loopVar;
+	
+	for(loopVar = 0; loopVar < numberOfCpus; loopVar++){
+		if(cores[loopVar].RunQueue.size > 0 && (victimIndex < 0 || cores[loopVar].RunQueue.size > cores[victimIndex].RunQueue.size)){
+			victimIndex = loopVar;
+		}
+	}
+	if(victimIndex < 0){
+		return 0;
+	}
+	dispatchProcess(&cores[thiefIndex], &cores[victimIndex].RunQueue, currentTime, timeQuantum);
+	cores[thiefIndex].steals++;
+	return 1;
+}
+
+// This function prints the utilization of every CPU, then how many processes migrated and how evenly the work was spread
+void printCoreTable(struct CpuCore *cores, int numberOfCpus, int totalCompletionTime){
+	long long totalBusyTime = 0;
+	long long mostBusyTime = 0;
+	long migrations = 0;
+	int loopVar;
+	
+	outputSummary("\nTable containing CPUs: \n");
+	outputSummary("%-5s| %-12s| %-12s| %-11s| %-12s| %-7s|\n", "CPU", "Busy Time", "Utilization", "Dispatches", "Completions", "Steals");
+	outputSummary("---------------------------------------------------------------------\n");
+	for(loopVar = 0; loopVar < numberOfCpus; loopVar++){
+		outputSummary("%-5d| %-12lld| %-12.3f| %-11ld| %-12ld| %-7ld|\n", loopVar, cores[loopVar].busyTime,
+			(totalCompletionTime > 0) ? (double)cores[loopVar].busyTime / totalCompletionTime : 0.0,
+			cores[loopVar].dispatches, cores[loopVar].completions, cores[loopVar].steals);
+		totalBusyTime += cores[loopVar].busyTime;
+		migrations += cores[loopVar].steals;
+		if(cores[loopVar].busyTime > mostBusyTime){
+			mostBusyTime = cores[loopVar].busyTime;
+		}
+	}
+	outputSummary("Migrations: %ld\n", migrations); // Every stolen process moved from one Run Queue to another
+	outputSummary("Load imbalance (most busy / average busy - 1): %.3f\n",
+		(totalBusyTime > 0) ? (double)mostBusyTime * numberOfCpus / totalBusyTime - 1.0 : 0.0);
+}
+
+// END OF MULTI-CORE FUNCTIONS
+// START OF BENCHMARK FUNCTIONS
+
+// The benchmark times every algorithm on seeded synthetic workloads of 10^3, 10^4, ... processes, and prints one CSV row per run
+// Workloads are generated with the same seed for every algorithm, so rows of the same size and pattern are directly comparable
+
+uint64_t nextRandom(uint64_t *state){ // splitmix64, so generated workloads are the same on every platform
+	uint64_t value = (*state += 0x9E3779B97F4A7C15ULL);
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+	return value ^ (value >> 31);
+}
+
+double randomUniform(uint64_t *state){ // Returns a value in (0, 1], so that its logarithm is always defined
+	return ((nextRandom(state) >> 11) + 1.0) / 9007199254740992.0;
+}
+
+// This function draws a burst time of at least 1 with a mean close to BENCHMARK_MEAN_BURST_TIME
+int randomBurstTime(uint64_t *state, enum WorkloadPattern pattern){
+	double burstTime;
+	if(pattern == HEAVYTAILEDWORKLOAD){ // Pareto with shape 1.5, whose mean is 3 times its minimum
+		burstTime = (BENCHMARK_MEAN_BURST_TIME / 3.0) / pow(randomUniform(state), 1.0 / 1.5);
+		if(burstTime > 100000.0){ // Capped so that total time stays within an int
+			burstTime = 100000.0;
+		}
+	}
+	else{ // Exponential
+		burstTime = -log(randomUniform(state)) * BENCHMARK_MEAN_BURST_TIME;
+	}
+	return (burstTime < 1.0) ? 1 : (int)burstTime;
+}
+
+void initWorkloadGenerator(struct WorkloadGenerator *generator, enum WorkloadPattern pattern, uint64_t seed){
+	generator->state = seed;
+	generator->pattern = pattern;
+	generator->arrivalTime = 0.0;
+	generator->generatedProcesses = 0;
+}
+
+// This function draws the next process of the workload, whose arrival time is never earlier than the previous one
+void nextGeneratedRecord(struct WorkloadGenerator *generator, struct TraceRecord *record){
+	double meanInterarrivalTime = BENCHMARK_MEAN_BURST_TIME / BENCHMARK_LOAD;
+	int waveSize = 50; // Processes in one wave of the bursty pattern
+	
+	if(generator->pattern == BURSTYWORKLOAD && generator->generatedProcesses % waveSize == 0 && generator->generatedProcesses > 0){ // Quiet period, long enough that the average load stays the same
+		generator->arrivalTime += -log(randomUniform(&generator->state)) * waveSize * (meanInterarrivalTime - 1.0);
+	}
+	record->processID = (int32_t)(generator->generatedProcesses % INT32_MAX) + 1; // IDs start again from 1 if an open system runs long enough
+	record->arrivalTime = (generator->arrivalTime < INT32_MAX) ? (int32_t)generator->arrivalTime : INT32_MAX;
+	record->burstTime = randomBurstTime(&generator->state, generator->pattern);
+	record->priority = 1 + (int32_t)(nextRandom(&generator->state) % 3);
+	if(generator->pattern == BURSTYWORKLOAD){ // Inside a wave, one process arrives per time unit on average
+		generator->arrivalTime += -log(randomUniform(&generator->state));
+	}
+	else{
+		generator->arrivalTime += -log(randomUniform(&generator->state)) * meanInterarrivalTime;
+	}
+	generator->generatedProcesses++;
+}
+
+// This function fills a new array with processes sorted by arrival time, returning the number of processes or -1 if there is no memory
+int generateWorkload(struct TraceRecord **workload, int numberOfProcesses, enum WorkloadPattern pattern, uint64_t seed){
+	struct WorkloadGenerator generator;
+	int loopVar;
+	
+	*workload = malloc(numberOfProcesses * sizeof(struct TraceRecord));
+	if(*workload == NULL){
+		printf("Workload cannot be generated as there is no more memory.\n");
+		return -1;
+	}
+	initWorkloadGenerator(&generator, pattern, seed);
+	for(loopVar = 0; loopVar < numberOfProcesses; loopVar++){
+		nextGeneratedRecord(&generator, &(*workload)[loopVar]);
+	}
+	return numberOfProcesses;
+}
+
+// This function writes the workload given in the command line as a binary trace, returning the exit code of the program
+int writeGeneratedWorkload(void){
+	struct TraceRecord *workload = NULL;
+	struct ProcessArena arena;
+	struct Process *JobQueue = NULL;
+	enum WorkloadPattern pattern = simulationOptions.workloadPattern;
+	int written;
+	
+	if(pattern == ALLWORKLOADS){ // A single pattern is needed, so Poisson is the default
+		pattern = POISSONWORKLOAD;
+	}
+	if(generateWorkload(&workload, simulationOptions.generatedProcesses, pattern, simulationOptions.seed) < 0){
+		return 1;
+	}
+	initProcessArena(&arena);
+	buildJobQueue(&arena, &JobQueue, workload, simulationOptions.generatedProcesses);
+	written = writeBinaryTrace(JobQueue, simulationOptions.generatedPath);
+	clearProcesses(&arena, &JobQueue);
+	freeProcessArena(&arena);
+	free(workload);
+	return written ? 0 : 1;
+}
+
+double elapsedSeconds(struct timespec *startTime){ // Wall time since startTime
+	struct timespec endTime;
+#ifndef _WIN32
+	clock_gettime(CLOCK_MONOTONIC, &endTime);
+#else
+	timespec_get(&endTime, TIME_UTC);
+#endif
+	return (endTime.tv_sec - startTime->tv_sec) + (endTime.tv_nsec - startTime->tv_nsec) / 1e9;
+}
+
+long peakMemoryKilobytes(void){ // Peak resident memory of this process so far, or 0 where it cannot be measured
+#ifndef _WIN32
+	struct rusage usage;
+	if(getrusage(RUSAGE_SELF, &usage) == 0){
+		return usage.ru_maxrss;
+	}
+#endif
+	return 0;
+}
+
+// This function runs one algorithm on the workload and prints its CSV row
+void runBenchmarkRow(enum WorkloadPattern pattern, enum SchedulingAlgorithm algorithm, struct ProcessArena *arena, struct Process **JobQueue,
+	const struct TraceRecord *workload, int numberOfProcesses){
+	enum OutputMode outputMode = simulationOptions.outputMode;
+	int timeQuantum = (algorithm == ROUNDROBIN || algorithm == ROUNDROBINNOIDLE || algorithm == MLFQ || algorithm == CFS) ? simulationOptions.timeQuantum : 0;
+	struct SchedulingResult result;
+	struct timespec startTime;
+	double seconds;
+	
+	buildJobQueue(arena, JobQueue, workload, numberOfProcesses); // Building the processes is not timed
+	simulationOptions.outputMode = SILENTOUTPUT; // Printing is not timed either
+#ifndef _WIN32
+	clock_gettime(CLOCK_MONOTONIC, &startTime);
+#else
+	timespec_get(&startTime, TIME_UTC);
+#endif
+	if(simulationOptions.numberOfCpus > 0){
+		result = multiCoreScheduling(algorithm, JobQueue, numberOfProcesses, timeQuantum);
+	}
+	else{
+		result = runAlgorithm(algorithm, JobQueue, numberOfProcesses, timeQuantum);
+	}
+	seconds = elapsedSeconds(&startTime);
+	simulationOptions.outputMode = outputMode;
+	printf("%s,%d,%s,%d,%d,%.6f,%lld,%.0f,%ld,%d,%.3f,%.3f,%d\n", workloadNames[pattern], numberOfProcesses, algorithmNames[algorithm],
+		(simulationOptions.numberOfCpus > 0) ? simulationOptions.numberOfCpus : 1, timeQuantum, seconds, result.numberOfEvents,
+		(seconds > 0) ? result.numberOfEvents / seconds : 0.0, peakMemoryKilobytes(), result.totalCompletionTime,
+		(double)result.totalTurnaroundTime / result.numberOfProcesses, (double)result.totalWaitingTime / result.numberOfProcesses, result.percentile99WaitingTime);
+	fflush(stdout); // Rows are shown as soon as they are ready, since large workloads take long
+}
+
+// This function runs the benchmark given in the command line, returning the exit code of the program
+// Where fork exists, every row runs in a child process, so the peak memory of a row is only that of its own run
+int runBenchmark(void){
+	enum SchedulingAlgorithm singleCpuAlgorithms[] = {FCFS, FCFSNOIDLE, ROUNDROBIN, ROUNDROBINNOIDLE, SJF, SRTF, PRIORITY, MLFQ, CFS};
+	enum SchedulingAlgorithm multiCoreAlgorithms[] = {FCFS, ROUNDROBIN, SJF, SRTF, PRIORITY}; // Same as runEveryAlgorithm
+	enum SchedulingAlgorithm *algorithms = singleCpuAlgorithms;
+	int numberOfAlgorithms = 9;
+	struct ProcessArena arena;
+	struct Process *JobQueue = NULL;
+	struct TraceRecord *workload = NULL;
+	int pattern, algorithmIndex, numberOfProcesses;
+	
+	if(simulationOptions.numberOfCpus > 0){
+		algorithms = multiCoreAlgorithms;
+		numberOfAlgorithms = 5;
+	}
+	initProcessArena(&arena);
+	printf("workload,processes,algorithm,cpus,quantum,seconds,events,events_per_second,peak_memory_kb,total_completion_time,average_turnaround_time,average_waiting_time,p99_waiting_time\n");
+	for(pattern = POISSONWORKLOAD; pattern < ALLWORKLOADS; pattern++){
+		if(simulationOptions.workloadPattern != ALLWORKLOADS && simulationOptions.workloadPattern != (enum WorkloadPattern)pattern){
+			continue;
+		}
+		for(numberOfProcesses = BENCHMARK_MINIMUM_PROCESSES; numberOfProcesses <= simulationOptions.benchmarkMaximumProcesses; numberOfProcesses *= 10){
+			if(generateWorkload(&workload, numberOfProcesses, (enum WorkloadPattern)pattern, simulationOptions.seed) < 0){
+				freeProcessArena(&arena);
+				return 1;
+			}
+			for(algorithmIndex = 0; algorithmIndex < numberOfAlgorithms; algorithmIndex++){
+				enum SchedulingAlgorithm algorithm = algorithms[algorithmIndex];
+#ifndef _WIN32
+				pid_t child;
+				fflush(stdout); // Otherwise the child would print the rows still buffered here a second time
+				child = fork();
+				if(child == 0){ // Each row runs in a child of its own, so its peak memory does not include the rows before it
+					runBenchmarkRow((enum WorkloadPattern)pattern, algorithm, &arena, &JobQueue, workload, numberOfProcesses);
+					_exit(0);
+				}
+				if(child > 0){
+					int status;
+					if(waitpid(child, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0){
+						printf("Run of %s on %d processes did not finish.\n", algorithmNames[algorithm], numberOfProcesses);
+					}
+					continue;
+				}
+#endif
+				runBenchmarkRow((enum WorkloadPattern)pattern, algorithm, &arena, &JobQueue, workload, numberOfProcesses); // Without fork, the peak memory is of every row so far
+			}
+			free(workload);
+			workload = NULL;
+			if(numberOfProcesses > INT32_MAX / 10){ // Next size would not fit in an int
+				break;
+			}
+		}
+	}
+	clearProcesses(&arena, &JobQueue);
+	freeProcessArena(&arena);
+	return 0;
+}
+
+// END OF BENCHMARK FUNCTIONS
+// START OF OPEN SYSTEM FUNCTIONS
+
+// In an open system, processes keep arriving from the generator (or a streamed trace) until the given duration has passed
+// A streamed trace may end earlier, in which case the run stops once every process has finished
+// Finished processes are reused for later arrivals and statistics are kept in histograms, so memory stays the same however long it runs
+// Every quarter of the window length, throughput, waiting time and queue length over the last window are reported
+
+// This function runs every algorithm as an open system, returning the exit code of the program
+int runOpenSystem(void){
+	enum SchedulingAlgorithm algorithms[] = {FCFS, ROUNDROBIN, SJF, SRTF, PRIORITY}; // Only policies that never need the whole Job Queue
+	int loopVar;
+	
+	for(loopVar = 0; loopVar < 5; loopVar++){
+		int timeQuantum = (algorithms[loopVar] == ROUNDROBIN) ? simulationOptions.timeQuantum : 0;
+		struct SchedulingResult result = openSystemScheduling(algorithms[loopVar], timeQuantum);
+		if(result.numberOfProcesses < 0){ // A trace could not be read
+			return 1;
+		}
+	}
+	return 0;
+}
+
+// This function runs one algorithm as an open system for openDuration units of simulated time
+// FCFS and Round Robin use a Ready Ring, the others a Ready Heap, and the CPU always runs until the next event in one step
+// Returns a result with -1 processes if the trace could not be read
+struct SchedulingResult openSystemScheduling(enum SchedulingAlgorithm algorithm, int timeQuantum){
+	enum SortingMetric sortingMetric = (algorithm == SJF) ? LEASTBURSTTIME : (algorithm == SRTF) ? LEASTREMAININGTIME : HIGHESTPRIORITY;
+	int useRing = (algorithm == FCFS || algorithm == ROUNDROBIN); // Arrivals come in order, so both are first-in first-out
+	int preemptive = (algorithm == SRTF || algorithm == PRIORITY); // A new arrival may take the CPU away from the running process
+	struct TraceStream stream;
+	struct TraceStream *streamPtr = NULL; // Arrivals come from the generator unless a trace is given
+	struct WorkloadGenerator generator;
+	struct TraceRecord generatedRecord;
+	struct ProcessArena openArena; // Only grows to the largest number of processes waiting at the same time
+	struct ReadyRing ReadyQueueRing;
+	struct ReadyHeap ReadyQueueHeap;
+	struct Process *FreeList = NULL; // Finished processes waiting to be reused
+	struct SlidingWindow window;
+	struct LatencyStatistics statistics;
+	struct SchedulingResult result = {0, 0, 0, 0, 0, 0};
+	const struct TraceRecord *nextRecord;
+	int endTime = simulationOptions.openDuration;
+	int currentTime = 0;
+	int previousArrivalTime = 0;
+	int readyProcesses = 0;
+	int roundRobin = 0;
+	int failed = 0;
+	
+	outputSummary("\n\nProceeding to %s in an open system for %d units of time...\n", algorithmNames[algorithm], endTime);
+	if(simulationOptions.tracePath != NULL){
+		if(!openTraceStream(&stream, simulationOptions.tracePath)){
+			result.numberOfProcesses = -1;
+			return result;
+		}
+		streamPtr = &stream;
+	}
+	else{
+		enum WorkloadPattern pattern = simulationOptions.workloadPattern;
+		initWorkloadGenerator(&generator, (pattern == ALLWORKLOADS) ? POISSONWORKLOAD : pattern, simulationOptions.seed);
+	}
+	initProcessArena(&openArena);
+	if(useRing){
+		failed = !initReadyRing(&ReadyQueueRing, 64);
+	}
+	else{
+		failed = !initReadyHeap(&ReadyQueueHeap, sortingMetric, 64);
+	}
+	initSlidingWindow(&window, simulationOptions.windowLength);
+	initLatencyStatistics(&statistics);
+	printWindowHeader();
+	nextRecord = nextArrival(streamPtr, &generator, &generatedRecord);
+	
+	while(!failed && currentTime < endTime && (nextRecord != NULL || readyProcesses > 0)){ // Nothing runs if the Ready Queue could not be created
+		struct Process *runningProcess;
+		int sliceLength;
+		result.numberOfEvents++;
+		while(nextRecord != NULL && nextRecord->arrivalTime <= currentTime){ // Same as longTermScheduler, but processes come from the source
+			struct Process *newPtr;
+			if(nextRecord->arrivalTime < previousArrivalTime){
+				printf("Trace must be sorted by arrival time to be streamed.\n");
+				failed = 1;
+				break;
+			}
+			previousArrivalTime = nextRecord->arrivalTime;
+			newPtr = admitTraceRecord(&openArena, &FreeList, nextRecord);
+			if(newPtr == NULL){
+				failed = 1;
+				break;
+			}
+			if(useRing){
+				pushToRing(&ReadyQueueRing, newPtr);
+			}
+			else{
+				insertToHeap(&ReadyQueueHeap, newPtr);
+			}
+			readyProcesses++;
+			nextRecord = nextArrival(streamPtr, &generator, &generatedRecord);
+		}
+		if(failed || (streamPtr != NULL && stream.error)){
+			failed = 1;
+			break;
+		}
+		if(roundRobin == 1){ // Same rotation as roundRobinScheduling, after the new arrivals joined the ring
+			rotateRing(&ReadyQueueRing);
+			roundRobin = 0;
+		}
+		if(readyProcesses == 0){ // Nothing to execute, so jump straight to the next arrival
+			int nextTime = (nextRecord->arrivalTime < endTime) ? nextRecord->arrivalTime : endTime;
+			advanceWindow(&window, currentTime, nextTime, 0);
+			currentTime = nextTime;
+			continue;
+		}
+		runningProcess = useRing ? peekRing(&ReadyQueueRing) : peekHeap(&ReadyQueueHeap);
+		recordFirstRun(runningProcess, currentTime);
+		sliceLength = runningProcess->remainingTime; // Run until the next event: completion, end of quantum, an arrival that may preempt, or the end
+		if(timeQuantum > 0){ // Quantums of a process alone in the Ready Queue are merged, as in roundRobinScheduling
+			sliceLength = roundRobinSliceLength(runningProcess->remainingTime, readyProcesses, currentTime,
+				(nextRecord != NULL) ? nextRecord->arrivalTime : -1, timeQuantum);
+			if(sliceLength > runningProcess->remainingTime){
+				sliceLength = runningProcess->remainingTime;
+			}
+		}
+		if(preemptive && nextRecord != NULL && nextRecord->arrivalTime - currentTime < sliceLength){
+			sliceLength = nextRecord->arrivalTime - currentTime;
+		}
+		if(endTime - currentTime < sliceLength){
+			sliceLength = endTime - currentTime;
+		}
+		advanceWindow(&window, currentTime, currentTime + sliceLength, readyProcesses);
+		currentTime += sliceLength;
+		runningProcess->remainingTime -= sliceLength;
+		if(runningProcess->remainingTime == 0){ // Process finishes, so it is recorded then kept for reuse
+			if(useRing){
+				popFromRing(&ReadyQueueRing);
+			}
+			else{
+				popFromHeap(&ReadyQueueHeap);
+			}
+			readyProcesses--;
+			recordLatencies(&statistics, runningProcess, currentTime);
+			recordWindowCompletion(&window, currentTime - runningProcess->arrivalTime - runningProcess->burstTime);
+			runningProcess->nextPtr = FreeList;
+			FreeList = runningProcess;
+		}
+		else if(useRing){
+			roundRobin = (timeQuantum > 0);
+		}
+		else if(sortingMetric == LEASTREMAININGTIME){ // Remaining time is the key of SRTF, so the running process moves down the heap
+			updateHeapKey(&ReadyQueueHeap, runningProcess, runningProcess->remainingTime);
+		}
+	}
+	copyStatisticsToResult(&statistics, &result);
+	result.totalCompletionTime = currentTime;
+	if(!failed && result.numberOfProcesses > 0){
+		outputSummary("Processes executed: %ld, still waiting: %d, process nodes allocated: %d\n", result.numberOfProcesses, readyProcesses, openArena.processCount);
+		printAveragesHeader();
+		printAverages(&result);
+		printLatencyStatistics(&statistics);
+	}
+	if(useRing){
+		freeReadyRing(&ReadyQueueRing);
+	}
+	else{
+		freeReadyHeap(&ReadyQueueHeap);
+	}
+	freeProcessArena(&openArena);
+	if(streamPtr != NULL){
+		closeTraceStream(&stream);
+	}
+	if(failed){
+		result.numberOfProcesses = -1;
+	}
+	return result;
+}
+
+// This function returns the next arriving process, from the trace if one is streamed or else from the generator
+// Returns NULL once the trace has ended (a generator never ends)
+const struct TraceRecord *nextArrival(struct TraceStream *stream, struct WorkloadGenerator *generator, struct TraceRecord *generatedRecord){
+	if(stream != NULL){
+		return nextTraceRecord(stream);
+	}
+	nextGeneratedRecord(generator, generatedRecord);
+	return generatedRecord;
+}
+
+void initSlidingWindow(struct SlidingWindow *window, int windowLength){
+	int loopVar;
+	window->stepLength = (windowLength / WINDOW_STEPS > 0) ? windowLength / WINDOW_STEPS : 1;
+	window->stepEndTime = window->stepLength;
+	window->currentStep = 0;
+	window->filledSteps = 0;
+	for(loopVar = 0; loopVar < WINDOW_STEPS; loopVar++){
+		window->steps[loopVar].completions = 0;
+		window->steps[loopVar].queueLengthTime = 0;
+		window->steps[loopVar].longestQueue = 0;
+		initOnlineStatistic(&window->steps[loopVar].waitingTime);
+	}
+}
+
+// This function accounts for queueLength processes being in the system from startTime to endTime
+// Every step closed on the way is reported, then the oldest step is cleared and reused for the next one
+void advanceWindow(struct SlidingWindow *window, int startTime, int endTime, int queueLength){
+	while(endTime >= window->stepEndTime){
+		struct WindowStep *step = &window->steps[window->currentStep];
+		step->queueLengthTime += (long long)queueLength * (window->stepEndTime - startTime);
+		if(queueLength > step->longestQueue && window->stepEndTime > startTime){
+			step->longestQueue = queueLength;
+		}
+		startTime = window->stepEndTime;
+		if(window->filledSteps < WINDOW_STEPS){
+			window->filledSteps++;
+		}
+		printWindow(window);
+		window->currentStep = (window->currentStep + 1) % WINDOW_STEPS;
+		step = &window->steps[window->currentStep];
+		step->completions = 0;
+		step->queueLengthTime = 0;
+		step->longestQueue = 0;
+		initOnlineStatistic(&step->waitingTime);
+		window->stepEndTime += window->stepLength;
+	}
+	window->steps[window->currentStep].queueLengthTime += (long long)queueLength * (endTime - startTime);
+	if(queueLength > window->steps[window->currentStep].longestQueue && endTime > startTime){
+		window->steps[window->currentStep].longestQueue = queueLength;
+	}
+}
+
+void recordWindowCompletion(struct SlidingWindow *window, int waitingTime){
+	window->steps[window->currentStep].completions++;
+	addToStatistic(&window->steps[window->currentStep].waitingTime, waitingTime);
+}
+
+void printWindowHeader(void){
+	outputSummary("\n%-12s| %-12s| %-20s| %-17s| %-20s| %-14s|\n", 
+	"Window End", "Throughput", "Avg Waiting Time", "p99 Waiting Time", "Avg Queue Length", "Longest Queue");
+	outputSummary("--------------------------------------------------------------------------------------------------------\n");
+}
+
+// This function prints the metrics of the last filledSteps steps, which cover the window ending at the step just closed
+void printWindow(struct SlidingWindow *window){
+	struct OnlineStatistic waitingTime;
+	long completions = 0;
+	long long queueLengthTime = 0;
+	int longestQueue = 0;
+	int windowLength = window->filledSteps * window->stepLength;
+	int loopVar;
+	
+	initOnlineStatistic(&waitingTime);
+	for(loopVar = 0; loopVar < window->filledSteps; loopVar++){ // Steps before the current one, going back in time
+		struct WindowStep *step = &window->steps[(window->currentStep - loopVar + WINDOW_STEPS) % WINDOW_STEPS];
+		completions += step->completions;
+		queueLengthTime += step->queueLengthTime;
+		if(step->longestQueue > longestQueue){
+			longestQueue = step->longestQueue;
+		}
+		mergeStatistic(&waitingTime, &step->waitingTime);
+	}
+	outputSummary("%-12lld| %-12.4f| %-20.3f| %-17d| %-20.3f| %-14d|\n", window->stepEndTime, (double)completions / windowLength,
+		waitingTime.mean, statisticPercentile(&waitingTime, 0.99), (double)queueLengthTime / windowLength, longestQueue);
+}
+
+// END OF OPEN SYSTEM FUNCTIONS
 // START OF MISCELLANEOUS FUNCTIONS
 
 void printLinkedList(struct Process *head) {
@@ -562,4 +4205,248 @@ void printLinkedList(struct Process *head) {
 }
 
 
+// This function reads the command line options into simulationOptions, returning 0 if an option is not recognized
+int readOptions(int argc, char *argv[]){
+	int loopVar;
+	for(loopVar = 1; loopVar < argc; loopVar++){
+		if(strcmp(argv[loopVar], "--event-clock") == 0){
+			simulationOptions.clockMode = EVENTCLOCK;
+		}
+		else if(strcmp(argv[loopVar], "--trace") == 0 && loopVar + 1 < argc){
+			simulationOptions.tracePath = argv[++loopVar];
+		}
+		else if(strcmp(argv[loopVar], "--stream") == 0){
+			simulationOptions.streamTrace = 1;
+		}
+		else if(strcmp(argv[loopVar], "--convert-trace") == 0 && loopVar + 1 < argc){
+			simulationOptions.binaryTracePath = argv[++loopVar];
+		}
+		else if(strcmp(argv[loopVar], "--sweep") == 0 && loopVar + 2 < argc){
+			simulationOptions.sweepMinimumQuantum = atoi(argv[++loopVar]);
+			simulationOptions.sweepMaximumQuantum = atoi(argv[++loopVar]);
+			if(simulationOptions.sweepMinimumQuantum <= 0 || simulationOptions.sweepMaximumQuantum < simulationOptions.sweepMinimumQuantum){
+				printf("Sweep needs a range of time quantums greater than zero.\n");
+				return 0;
+			}
+		}
+		else if(strcmp(argv[loopVar], "--autotune") == 0 && loopVar + 2 < argc){
+			simulationOptions.autotuneMinimumQuantum = atoi(argv[++loopVar]);
+			simulationOptions.autotuneMaximumQuantum = atoi(argv[++loopVar]);
+			if(simulationOptions.autotuneMinimumQuantum <= 0 || simulationOptions.autotuneMaximumQuantum < simulationOptions.autotuneMinimumQuantum){
+				printf("Autotune needs a range of time quantums greater than zero.\n");
+				return 0;
+			}
+		}
+		else if(strcmp(argv[loopVar], "--objective") == 0 && loopVar + 1 < argc){
+			loopVar++;
+			if(strcmp(argv[loopVar], "waiting") == 0){
+				simulationOptions.tuningObjective = AVERAGEWAITINGOBJECTIVE;
+			}
+			else if(strcmp(argv[loopVar], "p99-turnaround") == 0){
+				simulationOptions.tuningObjective = P99TURNAROUNDOBJECTIVE;
+			}
+			else if(strcmp(argv[loopVar], "switches") == 0){
+				simulationOptions.tuningObjective = CONTEXTSWITCHOBJECTIVE;
+			}
+			else{
+				printf("Unknown objective: %s\n", argv[loopVar]);
+				return 0;
+			}
+		}
+		else if(strcmp(argv[loopVar], "--threads") == 0 && loopVar + 1 < argc){
+			simulationOptions.numberOfThreads = atoi(argv[++loopVar]);
+			if(simulationOptions.numberOfThreads <= 0){
+				printf("Number of threads must be greater than zero.\n");
+				return 0;
+			}
+		}
+		else if(strcmp(argv[loopVar], "--output") == 0 && loopVar + 1 < argc){
+			loopVar++;
+			if(strcmp(argv[loopVar], "text") == 0){
+				simulationOptions.outputMode = TEXTOUTPUT;
+			}
+			else if(strcmp(argv[loopVar], "quiet") == 0){
+				simulationOptions.outputMode = QUIETOUTPUT;
+			}
+			else if(strcmp(argv[loopVar], "buffered") == 0){
+				simulationOptions.outputMode = BUFFEREDOUTPUT;
+			}
+			else if(strcmp(argv[loopVar], "binary") == 0){
+				simulationOptions.outputMode = BINARYOUTPUT;
+			}
+			else{
+				printf("Unknown output mode: %s\n", argv[loopVar]);
+				return 0;
+			}
+		}
+		else if(strcmp(argv[loopVar], "--gantt-file") == 0 && loopVar + 1 < argc){
+			simulationOptions.ganttPath = argv[++loopVar];
+		}
+		else if(strcmp(argv[loopVar], "--cpus") == 0 && loopVar + 1 < argc){
+			simulationOptions.numberOfCpus = atoi(argv[++loopVar]);
+			if(simulationOptions.numberOfCpus <= 0){
+				printf("Number of CPUs must be greater than zero.\n");
+				return 0;
+			}
+		}
+		else if(strcmp(argv[loopVar], "--placement") == 0 && loopVar + 1 < argc){
+			loopVar++;
+			if(strcmp(argv[loopVar], "round-robin") == 0){
+				simulationOptions.placementPolicy = ROUNDROBINPLACEMENT;
+			}
+			else if(strcmp(argv[loopVar], "least-loaded") == 0){
+				simulationOptions.placementPolicy = LEASTLOADEDPLACEMENT;
+			}
+			else if(strcmp(argv[loopVar], "single") == 0){
+				simulationOptions.placementPolicy = SINGLEPLACEMENT;
+			}
+			else{
+				printf("Unknown placement policy: %s\n", argv[loopVar]);
+				return 0;
+			}
+		}
+		else if(strcmp(argv[loopVar], "--benchmark") == 0 && loopVar + 1 < argc){
+			simulationOptions.benchmarkMaximumProcesses = atoi(argv[++loopVar]);
+			if(simulationOptions.benchmarkMaximumProcesses < BENCHMARK_MINIMUM_PROCESSES){
+				printf("Benchmark needs at least %d processes.\n", BENCHMARK_MINIMUM_PROCESSES);
+				return 0;
+			}
+		}
+		else if(strcmp(argv[loopVar], "--generate") == 0 && loopVar + 2 < argc){
+			simulationOptions.generatedProcesses = atoi(argv[++loopVar]);
+			simulationOptions.generatedPath = argv[++loopVar];
+			if(simulationOptions.generatedProcesses <= 0){
+				printf("Number of generated processes must be greater than zero.\n");
+				return 0;
+			}
+		}
+		else if(strcmp(argv[loopVar], "--workload") == 0 && loopVar + 1 < argc){
+			loopVar++;
+			if(strcmp(argv[loopVar], "poisson") == 0){
+				simulationOptions.workloadPattern = POISSONWORKLOAD;
+			}
+			else if(strcmp(argv[loopVar], "heavy-tailed") == 0){
+				simulationOptions.workloadPattern = HEAVYTAILEDWORKLOAD;
+			}
+			else if(strcmp(argv[loopVar], "bursty") == 0){
+				simulationOptions.workloadPattern = BURSTYWORKLOAD;
+			}
+			else{
+				printf("Unknown workload: %s\n", argv[loopVar]);
+				return 0;
+			}
+		}
+		else if(strcmp(argv[loopVar], "--seed") == 0 && loopVar + 1 < argc){
+			simulationOptions.seed = strtoull(argv[++loopVar], NULL, 10);
+		}
+		else if(strcmp(argv[loopVar], "--no-stealing") == 0){
+			simulationOptions.workStealing = 0;
+		}
+		else if(strcmp(argv[loopVar], "--open") == 0 && loopVar + 1 < argc){
+			simulationOptions.openDuration = atoi(argv[++loopVar]);
+			if(simulationOptions.openDuration <= 0){
+				printf("Open system needs a duration greater than zero.\n");
+				return 0;
+			}
+		}
+		else if(strcmp(argv[loopVar], "--window") == 0 && loopVar + 1 < argc){
+			simulationOptions.windowLength = atoi(argv[++loopVar]);
+			if(simulationOptions.windowLength <= 0){
+				printf("Window length must be greater than zero.\n");
+				return 0;
+			}
+		}
+		else if(strcmp(argv[loopVar], "--mlfq-quanta") == 0 && loopVar + 1 < argc){
+			char *quantum = argv[++loopVar];
+			char *end;
+			simulationOptions.mlfqLevels = 0;
+			do{ // Time quantums are separated by commas, one per level starting from the highest
+				if(simulationOptions.mlfqLevels == MLFQ_MAXIMUM_LEVELS){
+					printf("Multilevel Feedback Queue can have at most %d levels.\n", MLFQ_MAXIMUM_LEVELS);
+					return 0;
+				}
+				simulationOptions.mlfqTimeQuanta[simulationOptions.mlfqLevels] = (int)strtol(quantum, &end, 10);
+				if(end == quantum || simulationOptions.mlfqTimeQuanta[simulationOptions.mlfqLevels] <= 0 || (*end != ',' && *end != '\0')){
+					printf("Time quantums of the levels must be greater than zero and separated by commas.\n");
+					return 0;
+				}
+				simulationOptions.mlfqLevels++;
+				quantum = end + 1;
+			}while(*end == ',');
+		}
+		else if(strcmp(argv[loopVar], "--mlfq-boost") == 0 && loopVar + 1 < argc){
+			simulationOptions.mlfqBoostPeriod = atoi(argv[++loopVar]);
+			if(simulationOptions.mlfqBoostPeriod < 0){
+				printf("Priority boost period cannot be negative.\n");
+				return 0;
+			}
+		}
+		else if(strcmp(argv[loopVar], "--quantum") == 0 && loopVar + 1 < argc){
+			simulationOptions.timeQuantum = atoi(argv[++loopVar]);
+			if(simulationOptions.timeQuantum <= 0){
+				printf("Time quantum must be greater than zero.\n");
+				return 0;
+			}
+		}
+		else{
+			printf("Unknown option: %s\n", argv[loopVar]);
+			return 0;
+		}
+	}
+	if(simulationOptions.outputMode == BINARYOUTPUT && simulationOptions.ganttPath == NULL){
+		printf("Binary output needs a Gantt Chart file.\n");
+		return 0;
+	}
+	if(simulationOptions.sweepMinimumQuantum > 0 && simulationOptions.tracePath == NULL){
+		printf("Sweep needs a trace.\n");
+		return 0;
+	}
+	if(simulationOptions.autotuneMinimumQuantum > 0 && (simulationOptions.tracePath == NULL || simulationOptions.sweepMinimumQuantum > 0
+	|| simulationOptions.streamTrace || simulationOptions.numberOfCpus > 0 || simulationOptions.openDuration > 0)){
+		printf("Autotune needs a trace, and cannot be combined with a sweep, a streamed trace, multiple CPUs or an open system.\n");
+		return 0;
+	}
+	if((simulationOptions.benchmarkMaximumProcesses > 0 || simulationOptions.generatedProcesses > 0)
+	&& (simulationOptions.tracePath != NULL || simulationOptions.sweepMinimumQuantum > 0)){
+		printf("Benchmark and generated workloads cannot be combined with a trace or a sweep.\n");
+		return 0;
+	}
+	if(simulationOptions.numberOfCpus > 0 && (simulationOptions.streamTrace || simulationOptions.sweepMinimumQuantum > 0)){
+		printf("Multiple CPUs cannot be combined with a streamed trace or a sweep.\n");
+		return 0;
+	}
+	if(simulationOptions.openDuration > 0 && (simulationOptions.numberOfCpus > 0 || simulationOptions.sweepMinimumQuantum > 0
+	|| simulationOptions.benchmarkMaximumProcesses > 0 || simulationOptions.generatedProcesses > 0 || simulationOptions.binaryTracePath != NULL)){
+		printf("Open system cannot be combined with multiple CPUs, a sweep, a benchmark or a converted or generated trace.\n");
+		return 0;
+	}
+	return 1;
+}
+
+void printUsage(char *programName){
+	printf("Usage: %s [options]\n", programName);
+	printf("  --event-clock           Jump straight to the next arrival while CPU is idle, instead of one time unit at a time\n");
+	printf("  --trace FILE            Load processes from a text or binary trace instead of the built-in test cases\n");
+	printf("  --stream                Feed the trace to the scheduler while reading it (trace must be sorted by arrival time)\n");
+	printf("  --convert-trace FILE    Write the loaded trace as a binary trace to FILE, then exit\n");
+	printf("  --quantum N             Time quantum of round robin for traces (default 3)\n");
+	printf("  --mlfq-quanta Q1,Q2,... One level of the Multilevel Feedback Queue per time quantum (default 3 levels: quantum, 2x and 4x)\n");
+	printf("  --mlfq-boost PERIOD     Move every process back to the highest level every PERIOD units of time, 0 for never (default %d)\n", MLFQ_DEFAULT_BOOST_PERIOD);
+	printf("  --output MODE           text (default), quiet (averages only), buffered (text written in large chunks) or binary\n");
+	printf("  --gantt-file FILE       File where binary output writes the Gantt Chart\n");
+	printf("  --sweep MIN MAX         Run every algorithm, and round robin with every quantum from MIN to MAX, in parallel on the trace\n");
+	printf("  --threads N             Number of workers used by the sweep (default one per CPU)\n");
+	printf("  --autotune MIN MAX      Find the round robin quantum from MIN to MAX that is best for the objective on the trace\n");
+	printf("  --objective NAME        What the autotune minimizes: waiting (default, average waiting time), p99-turnaround or switches\n");
+	printf("  --cpus N                Run the algorithms on N simulated CPUs, each with its own Run Queue\n");
+	printf("  --placement POLICY      CPU given to an arriving process: least-loaded (default), round-robin or single\n");
+	printf("  --no-stealing           CPUs with nothing to execute do not take waiting processes from other CPUs\n");
+	printf("  --benchmark MAX         Time every algorithm on generated workloads of 1000, 10000, ... up to MAX processes, printed as CSV\n");
+	printf("  --generate N FILE       Write a generated workload of N processes to FILE as a binary trace, then exit\n");
+	printf("  --workload PATTERN      Generated workload: poisson, heavy-tailed or bursty (default every pattern for the benchmark, poisson otherwise)\n");
+	printf("  --seed N                Seed of the workload generator (default 1)\n");
+	printf("  --open DURATION         Run as an open system for DURATION units of time, fed by the generator or by the streamed trace\n");
+	printf("  --window LENGTH         Length of the sliding window reported by the open system (default 1000)\n");
+}
+
 // END OF MISCELLANEOUS FUNCTIONS
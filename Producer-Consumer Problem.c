@@ -4,9 +4,83 @@
 #include <semaphore.h>  // For semaphores
 #include <unistd.h>     // For sleep function
 #include <time.h>       // For random number seeding
+#include <string.h>     // For reading command line options
+#include <sched.h>      // For yielding the CPU while a lock-free buffer is full or empty
+#include <stdint.h>     // For signed differences of queue positions
+#include <stdatomic.h>  // For the lock-free buffer
+#include <stdalign.h>   // For aligning the padded layout to cache lines
 
-// Struct to hold buffer and synchronization variables
+#define MAX_SWEEP_VALUES 16        // Most buffer sizes or thread counts the benchmark can sweep
+#define LATENCY_SUB_BUCKETS 16     // Buckets per power of two, so a percentile is within 1/16 of the exact value
+#define LATENCY_BUCKETS (32 * LATENCY_SUB_BUCKETS) // Enough buckets for every latency an item can carry
+#define LATENCY_MASK 0x7fffffff    // Items carry the low 31 bits of their enqueue time in nanoseconds, so latencies up to 2 seconds are exact
+#define CACHE_LINE_SIZE 64         // Bytes moved between cores as one unit, so data written by different cores should not share one
+#define STOP_ITEM -1               // Item that tells a consumer of the benchmark to stop, since every timestamp is non-negative
+
+// Ways the buffer can be synchronized, chosen at startup
+typedef enum {
+    SEMAPHOREBUFFER,               // Semaphores count the slots and a mutex protects the indexes
+    LOCKFREEBUFFER,                // Lock-free queue, using the single-producer single-consumer fast path when there is one of each
+    MPMCBUFFER,                    // Lock-free multi-producer multi-consumer queue, even when there is one producer and one consumer
+    SHARDEDBUFFER                  // One lock-free queue (shard) per producer, where consumers steal from other shards once theirs is empty
+} BufferMode;
+
+const char *bufferModeNames[] = {"semaphore", "lock-free", "mpmc", "sharded"};
+
+// Ways the positions of a lock-free buffer can be laid out in memory, chosen at startup
+typedef enum {
+    COMPACTLAYOUT,                 // Both positions sit next to each other and to the rest of the Buffer, so every write invalidates the line for both sides
+    PADDEDLAYOUT                   // Each position has a cache line of its own, next to a copy of the other position that only its side reads
+} BufferLayout;
+
+const char *bufferLayoutNames[] = {"compact", "padded"};
+
+// Options given in the command line
+typedef struct {
+    BufferMode mode;
+    int modeGiven;                 // If 0, the benchmark compares every mode
+    BufferLayout layout;
+    int layoutGiven;               // If 0, the benchmark compares both layouts of the lock-free modes
+    int batchSize;
+    int benchmark;                 // If 1, the benchmark runs instead of the interactive simulation
+    long items;                    // Items moved by each run of the benchmark
+    double duration;               // If greater than zero, each run lasts this many seconds instead of moving a number of items
+    int bufferSizes[MAX_SWEEP_VALUES];
+    int numberOfBufferSizes;
+    int producerCounts[MAX_SWEEP_VALUES];
+    int consumerCounts[MAX_SWEEP_VALUES];
+    int numberOfThreadCounts;
+} Options;
+
+Options options = {SEMAPHOREBUFFER, 0, COMPACTLAYOUT, 0, 1, 0, 1000000, 0.0, {1, 16, 1024}, 3, {1, 2, 4, 8}, {1, 2, 4, 8}, 4};
+
+// Slot of the lock-free multi-producer multi-consumer queue
+typedef struct {
+    atomic_size_t sequence;        // Equals the position of the next item to be added here while empty, and that position + 1 once filled
+    int item;
+} Slot;
+
+// Position of one side of a lock-free queue, written only by that side
+typedef struct {
+    atomic_size_t position;        // Number of items this side ever added (producers) or removed (consumers)
+    size_t cachedOppositePosition; // Position of the other side when this side last read it, used only in the padded layout
+} QueueSide;
+
+// A QueueSide alone on its cache line, so writing one side never invalidates the line the other side is reading
+typedef struct {
+    alignas(CACHE_LINE_SIZE) QueueSide side;
+} PaddedQueueSide;
+
+// A counter alone on its cache line, so updating it does not invalidate the fields read next to it
 typedef struct {
+    alignas(CACHE_LINE_SIZE) atomic_int count;
+} PaddedCounter;
+
+_Thread_local int producerTicket = -1; // Order in which this thread first added to a sharded buffer, which picks its shard
+_Thread_local int consumerTicket = -1; // Order in which this thread first removed from a sharded buffer, which picks its home shard
+
+// Struct to hold buffer and synchronization variables
+typedef struct Buffer {
     int *buffer;                   // Pointer to the buffer array
     int bufferSize;                // Size of the buffer
     int inIndex;                   // Index where the producer will add the next item
@@ -15,8 +89,275 @@ typedef struct {
     sem_t fullSlot;                // Semaphore to track the number of filled slots
     sem_t emptySlot;               // Semaphore to track the number of empty slots
     pthread_mutex_t mutexToAccessBuffer; // Mutex to protect shared data access
+    BufferMode mode;               // How producers and consumers are synchronized
+    int singleProducerSingleConsumer; // 1 if the lock-free queue has one producer and one consumer, so no compare-and-swap is needed
+    Slot *slots;                   // Slots of the multi-producer multi-consumer queue (the fast path uses buffer instead)
+    int slotCount;                 // Number of slots, which is the buffer size but at least 2
+    QueueSide *producerSide;       // Side of the lock-free queue written by producers, so the slot of the next item is its position modulo the buffer size
+    QueueSide *consumerSide;       // Side written by consumers
+    BufferLayout layout;
+    QueueSide compactSides[2];     // Both sides in the compact layout
+    PaddedQueueSide *paddedSides;  // Both sides in the padded layout, or NULL
+    struct Buffer *shards;         // Multi-producer multi-consumer queues of a sharded buffer, one per producer, or NULL
+    int numberOfShards;
+    PaddedCounter *freeSlots;      // Empty slots left in all shards together, which is what producers of a sharded buffer wait for
+    atomic_int nextProducerTicket;
+    atomic_int nextConsumerTicket;
+    int batchSize;                 // Most items each producer or consumer moves in one operation
 } Buffer;
 
+void destroyBuffer(Buffer *myBuffer);
+
+// This function returns 1 once the buffer is ready, or 0 if there is not enough memory, in which case nothing is left to free
+int initBuffer(Buffer *myBuffer, int bufferSize, BufferMode mode, BufferLayout layout, int numProducers, int numConsumers, int batchSize) {
+    int loopVar;
+    myBuffer->bufferSize = bufferSize;
+    myBuffer->buffer = (int *)malloc(bufferSize * sizeof(int)); // Allocate memory for the buffer
+    if (myBuffer->buffer == NULL) {
+        printf("Buffer cannot be created as there is no more memory.\n");
+        return 0;
+    }
+    myBuffer->slots = NULL;            // Arrays not allocated yet are NULL, so destroyBuffer can release a buffer that was only partly created
+    myBuffer->paddedSides = NULL;
+    myBuffer->shards = NULL;
+    myBuffer->numberOfShards = 0;
+    myBuffer->freeSlots = NULL;
+    
+    for(loopVar = 0; loopVar< bufferSize; loopVar++){
+    	myBuffer->buffer[loopVar] = 0;
+	}
+    myBuffer->inIndex = 0;             // Initialize producer index
+    myBuffer->outIndex = 0;            // Initialize consumer index
+    myBuffer->bufferCount = 0;         // Initialize item count
+    sem_init(&myBuffer->fullSlot, 0, 0); // Initialize "full" semaphore with 0 (no items initially)
+    sem_init(&myBuffer->emptySlot, 0, bufferSize); // Initialize "empty" semaphore with the buffer size
+    pthread_mutex_init(&myBuffer->mutexToAccessBuffer, NULL); // Initialize the mutex
+
+    myBuffer->mode = mode;
+    myBuffer->singleProducerSingleConsumer = (mode == LOCKFREEBUFFER && numProducers == 1 && numConsumers == 1);
+    // With one slot, the sequence of a filled slot (position + 1) would also mean empty and waiting for the next position
+    // So a buffer of size 1 gets two slots, and its producers check the consumers' position to hold at most one item
+    myBuffer->slotCount = (bufferSize > 1) ? bufferSize : 2;
+    myBuffer->slots = (Slot *)malloc(myBuffer->slotCount * sizeof(Slot));
+    if (myBuffer->slots == NULL) {
+        printf("Buffer cannot be created as there is no more memory.\n");
+        destroyBuffer(myBuffer);
+        return 0;
+    }
+    for(loopVar = 0; loopVar < myBuffer->slotCount; loopVar++){
+    	atomic_init(&myBuffer->slots[loopVar].sequence, (size_t)loopVar); // Slot i first waits for the item at position i
+    	myBuffer->slots[loopVar].item = 0;
+	}
+    myBuffer->layout = layout;
+    if (layout == PADDEDLAYOUT) {
+        myBuffer->paddedSides = (PaddedQueueSide *)aligned_alloc(CACHE_LINE_SIZE, 2 * sizeof(PaddedQueueSide));
+        if (myBuffer->paddedSides == NULL) {
+            printf("Buffer cannot be created as there is no more memory.\n");
+            destroyBuffer(myBuffer);
+            return 0;
+        }
+        myBuffer->producerSide = &myBuffer->paddedSides[0].side;
+        myBuffer->consumerSide = &myBuffer->paddedSides[1].side;
+    }
+    else {
+        myBuffer->producerSide = &myBuffer->compactSides[0];
+        myBuffer->consumerSide = &myBuffer->compactSides[1];
+    }
+    atomic_init(&myBuffer->producerSide->position, 0);
+    atomic_init(&myBuffer->consumerSide->position, 0);
+    myBuffer->producerSide->cachedOppositePosition = 0;
+    myBuffer->consumerSide->cachedOppositePosition = 0;
+    atomic_init(&myBuffer->nextProducerTicket, 0);
+    atomic_init(&myBuffer->nextConsumerTicket, 0);
+    if (mode == SHARDEDBUFFER) {
+        // Each shard can hold every item, so a producer is only ever held back by the capacity of the whole buffer
+        myBuffer->shards = (struct Buffer *)malloc(numProducers * sizeof(struct Buffer));
+        if (myBuffer->shards == NULL) {
+            printf("Buffer cannot be created as there is no more memory.\n");
+            destroyBuffer(myBuffer);
+            return 0;
+        }
+        for (loopVar = 0; loopVar < numProducers; loopVar++) {
+            if (!initBuffer(&myBuffer->shards[loopVar], bufferSize, MPMCBUFFER, layout, 1, numConsumers, batchSize)) { // The shard already said why, and freed itself
+                destroyBuffer(myBuffer);     // Only the shards counted so far are destroyed
+                return 0;
+            }
+            myBuffer->numberOfShards++;
+        }
+        myBuffer->freeSlots = (PaddedCounter *)aligned_alloc(CACHE_LINE_SIZE, sizeof(PaddedCounter));
+        if (myBuffer->freeSlots == NULL) {
+            printf("Buffer cannot be created as there is no more memory.\n");
+            destroyBuffer(myBuffer);
+            return 0;
+        }
+        atomic_init(&myBuffer->freeSlots->count, bufferSize);
+    }
+    myBuffer->batchSize = batchSize;
+    return 1;
+}
+
+void destroyBuffer(Buffer *myBuffer) {
+    int loopVar;
+    free(myBuffer->buffer);                  // Free the buffer memory
+    free(myBuffer->slots);
+    free(myBuffer->paddedSides);
+    for (loopVar = 0; loopVar < myBuffer->numberOfShards; loopVar++) {
+        destroyBuffer(&myBuffer->shards[loopVar]);
+    }
+    free(myBuffer->shards);
+    free(myBuffer->freeSlots);
+    sem_destroy(&myBuffer->fullSlot);        // Destroy the "full" semaphore
+    sem_destroy(&myBuffer->emptySlot);       // Destroy the "empty" semaphore
+    pthread_mutex_destroy(&myBuffer->mutexToAccessBuffer); // Destroy the mutex
+}
+
+// Returns a consumer position for the producer at position that allows needed empty slots if possible
+// In the padded layout, the consumers' cache line is only read again once the copy from the last read no longer allows them
+size_t consumerPositionForProducer(Buffer *myBuffer, size_t position, size_t needed) {
+    QueueSide *producerSide = myBuffer->producerSide;
+    if (myBuffer->layout == COMPACTLAYOUT || myBuffer->bufferSize - (position - producerSide->cachedOppositePosition) < needed) {
+        producerSide->cachedOppositePosition = atomic_load_explicit(&myBuffer->consumerSide->position, memory_order_acquire);
+    }
+    return producerSide->cachedOppositePosition;
+}
+
+// Same as consumerPositionForProducer, for the consumer at position that needs filled slots
+size_t producerPositionForConsumer(Buffer *myBuffer, size_t position, size_t needed) {
+    QueueSide *consumerSide = myBuffer->consumerSide;
+    if (myBuffer->layout == COMPACTLAYOUT || consumerSide->cachedOppositePosition - position < needed) {
+        consumerSide->cachedOppositePosition = atomic_load_explicit(&myBuffer->producerSide->position, memory_order_acquire);
+    }
+    return consumerSide->cachedOppositePosition;
+}
+
+// Single-producer single-consumer fast path: only the producer writes its position and only the consumer writes its own
+// The release store of a position publishes the slot to the other thread, whose acquire load sees the slot before the position
+int tryPutSingle(Buffer *myBuffer, int item) {
+    size_t position = atomic_load_explicit(&myBuffer->producerSide->position, memory_order_relaxed); // Only this thread changes it
+    if (position - consumerPositionForProducer(myBuffer, position, 1) == (size_t)myBuffer->bufferSize) {
+        return 0;                            // Buffer is full
+    }
+    myBuffer->buffer[position % myBuffer->bufferSize] = item;
+    atomic_store_explicit(&myBuffer->producerSide->position, position + 1, memory_order_release);
+    return 1;
+}
+
+int tryTakeSingle(Buffer *myBuffer, int *item) {
+    size_t position = atomic_load_explicit(&myBuffer->consumerSide->position, memory_order_relaxed);
+    if (position == producerPositionForConsumer(myBuffer, position, 1)) {
+        return 0;                            // Buffer is empty
+    }
+    *item = myBuffer->buffer[position % myBuffer->bufferSize];
+    atomic_store_explicit(&myBuffer->consumerSide->position, position + 1, memory_order_release);
+    return 1;
+}
+
+// Returns how many of count items the producer at position may add to a queue with more slots than its buffer size
+// Otherwise the sequences alone keep the buffer from overflowing, so count is returned without reading the consumers' position
+int emptySlotsForProducer(Buffer *myBuffer, size_t position, int count) {
+    if (myBuffer->slotCount > myBuffer->bufferSize) {
+        size_t filledSlots = position - atomic_load_explicit(&myBuffer->consumerSide->position, memory_order_acquire);
+        if (filledSlots >= (size_t)myBuffer->bufferSize) {
+            return 0;
+        }
+        if ((size_t)count > myBuffer->bufferSize - filledSlots) {
+            count = (int)(myBuffer->bufferSize - filledSlots);
+        }
+    }
+    return count;
+}
+
+// Multi-producer multi-consumer queue with a sequence number per slot
+// A producer claims a position with compare-and-swap only once the slot of that position says it is empty, so producers never wait for each other's writes
+// Filling the slot then setting its sequence to position + 1 hands it to the consumer that claims the same position
+int tryPutMultiple(Buffer *myBuffer, int item) {
+    size_t position = atomic_load_explicit(&myBuffer->producerSide->position, memory_order_relaxed);
+    Slot *slot;
+    while (1) {
+        slot = &myBuffer->slots[position % myBuffer->slotCount];
+        intptr_t difference = (intptr_t)atomic_load_explicit(&slot->sequence, memory_order_acquire) - (intptr_t)position;
+        if (difference == 0) {               // Slot is empty, so try to claim this position
+            if (emptySlotsForProducer(myBuffer, position, 1) == 0) {
+                return 0;                    // Buffer of size 1 still holds an item nobody has taken
+            }
+            if (atomic_compare_exchange_weak_explicit(&myBuffer->producerSide->position, &position, position + 1, memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }                                // On failure, position now holds the position another producer left
+        }
+        else if (difference < 0) {           // Slot still holds the item from one lap ago, so the buffer is full
+            return 0;
+        }
+        else {                               // Another producer already claimed this position
+            position = atomic_load_explicit(&myBuffer->producerSide->position, memory_order_relaxed);
+        }
+    }
+    slot->item = item;
+    atomic_store_explicit(&slot->sequence, position + 1, memory_order_release); // Publish the item to consumers
+    return 1;
+}
+
+int tryTakeMultiple(Buffer *myBuffer, int *item) {
+    size_t position = atomic_load_explicit(&myBuffer->consumerSide->position, memory_order_relaxed);
+    Slot *slot;
+    while (1) {
+        slot = &myBuffer->slots[position % myBuffer->slotCount];
+        intptr_t difference = (intptr_t)atomic_load_explicit(&slot->sequence, memory_order_acquire) - (intptr_t)(position + 1);
+        if (difference == 0) {               // Slot is filled, so try to claim this position
+            if (atomic_compare_exchange_weak_explicit(&myBuffer->consumerSide->position, &position, position + 1, memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (difference < 0) {           // Slot has not been filled yet, so the buffer is empty
+            return 0;
+        }
+        else {
+            position = atomic_load_explicit(&myBuffer->consumerSide->position, memory_order_relaxed);
+        }
+    }
+    *item = slot->item;
+    atomic_store_explicit(&slot->sequence, position + myBuffer->slotCount, memory_order_release); // Slot is empty again, for the item one lap later
+    return 1;
+}
+
+int putBatch(Buffer *myBuffer, const int *items, int count);
+int takeBatch(Buffer *myBuffer, int *items, int maxCount);
+
+// Adds an item to a lock-free buffer, yielding the CPU while it is full
+void putToLockFreeBuffer(Buffer *myBuffer, int item) {
+    if (myBuffer->mode == SHARDEDBUFFER) {
+        putBatch(myBuffer, &item, 1);
+    }
+    else if (myBuffer->singleProducerSingleConsumer) {
+        while (!tryPutSingle(myBuffer, item)) {
+            sched_yield();
+        }
+    }
+    else {
+        while (!tryPutMultiple(myBuffer, item)) {
+            sched_yield();
+        }
+    }
+}
+
+// Removes an item from a lock-free buffer, yielding the CPU while it is empty
+int takeFromLockFreeBuffer(Buffer *myBuffer) {
+    int item;
+    if (myBuffer->mode == SHARDEDBUFFER) {
+        takeBatch(myBuffer, &item, 1);
+    }
+    else if (myBuffer->singleProducerSingleConsumer) {
+        while (!tryTakeSingle(myBuffer, &item)) {
+            sched_yield();
+        }
+    }
+    else {
+        while (!tryTakeMultiple(myBuffer, &item)) {
+            sched_yield();
+        }
+    }
+    return item;
+}
+
 void printBuffer(int *myBuffer, int bufferSize) {
     int loopVar;
 	printf("Buffer: [");
@@ -29,12 +370,253 @@ void printBuffer(int *myBuffer, int bufferSize) {
     printf("]\n");
 }
 
+// Copies count items from items into the ring starting at index start, in two pieces if they wrap around the end of the ring
+void copyIntoRing(int *ring, int ringSize, int start, const int *items, int count) {
+    int firstPiece = (count < ringSize - start) ? count : ringSize - start;
+    memcpy(ring + start, items, firstPiece * sizeof(int));
+    memcpy(ring, items + firstPiece, (count - firstPiece) * sizeof(int));
+}
+
+// Copies count items from the ring starting at index start into items
+void copyFromRing(const int *ring, int ringSize, int start, int *items, int count) {
+    int firstPiece = (count < ringSize - start) ? count : ringSize - start;
+    memcpy(items, ring + start, firstPiece * sizeof(int));
+    memcpy(items + firstPiece, ring, (count - firstPiece) * sizeof(int));
+}
+
+// Fast path of putBatch: every empty slot is reserved at once, and one release store publishes all of them
+int tryPutBatchSingle(Buffer *myBuffer, const int *items, int count) {
+    size_t position = atomic_load_explicit(&myBuffer->producerSide->position, memory_order_relaxed);
+    size_t emptySlots = myBuffer->bufferSize - (position - consumerPositionForProducer(myBuffer, position, count));
+    if ((size_t)count > emptySlots) {
+        count = (int)emptySlots;
+    }
+    copyIntoRing(myBuffer->buffer, myBuffer->bufferSize, (int)(position % myBuffer->bufferSize), items, count);
+    atomic_store_explicit(&myBuffer->producerSide->position, position + count, memory_order_release);
+    return count;
+}
+
+int tryTakeBatchSingle(Buffer *myBuffer, int *items, int maxCount) {
+    size_t position = atomic_load_explicit(&myBuffer->consumerSide->position, memory_order_relaxed);
+    size_t filledSlots = producerPositionForConsumer(myBuffer, position, maxCount) - position;
+    if ((size_t)maxCount > filledSlots) {
+        maxCount = (int)filledSlots;
+    }
+    copyFromRing(myBuffer->buffer, myBuffer->bufferSize, (int)(position % myBuffer->bufferSize), items, maxCount);
+    atomic_store_explicit(&myBuffer->consumerSide->position, position + maxCount, memory_order_release);
+    return maxCount;
+}
+
+// Multi-producer version of putBatch: the run of empty slots from the next position is claimed with a single compare-and-swap
+// If the swap succeeds, no other producer claimed those positions in between, so they are still empty
+// Each slot is still published on its own, since each one may be taken by a different consumer
+int tryPutBatchMultiple(Buffer *myBuffer, const int *items, int count) {
+    size_t position = atomic_load_explicit(&myBuffer->producerSide->position, memory_order_relaxed);
+    int claimed, loopVar;
+    while (1) {
+        claimed = 0;
+        while (claimed < count && atomic_load_explicit(&myBuffer->slots[(position + claimed) % myBuffer->slotCount].sequence, memory_order_acquire) == position + claimed) {
+            claimed++;                       // Slot is empty and waiting for this position
+        }
+        if (claimed == 0) {
+            size_t sequence = atomic_load_explicit(&myBuffer->slots[position % myBuffer->slotCount].sequence, memory_order_acquire);
+            if ((intptr_t)sequence - (intptr_t)position < 0) { // Slot still holds the item from one lap ago, so the buffer is full
+                return 0;
+            }
+            position = atomic_load_explicit(&myBuffer->producerSide->position, memory_order_relaxed); // Another producer already claimed it
+            continue;
+        }
+        claimed = emptySlotsForProducer(myBuffer, position, claimed);
+        if (claimed == 0) {
+            return 0;
+        }
+        if (atomic_compare_exchange_weak_explicit(&myBuffer->producerSide->position, &position, position + claimed, memory_order_relaxed, memory_order_relaxed)) {
+            break;
+        }
+    }
+    for (loopVar = 0; loopVar < claimed; loopVar++) {
+        Slot *slot = &myBuffer->slots[(position + loopVar) % myBuffer->slotCount];
+        slot->item = items[loopVar];
+        atomic_store_explicit(&slot->sequence, position + loopVar + 1, memory_order_release);
+    }
+    return claimed;
+}
+
+int tryTakeBatchMultiple(Buffer *myBuffer, int *items, int maxCount) {
+    size_t position = atomic_load_explicit(&myBuffer->consumerSide->position, memory_order_relaxed);
+    int claimed, loopVar;
+    while (1) {
+        claimed = 0;
+        while (claimed < maxCount && atomic_load_explicit(&myBuffer->slots[(position + claimed) % myBuffer->slotCount].sequence, memory_order_acquire) == position + claimed + 1) {
+            claimed++;                       // Slot is filled with the item of this position
+        }
+        if (claimed == 0) {
+            size_t sequence = atomic_load_explicit(&myBuffer->slots[position % myBuffer->slotCount].sequence, memory_order_acquire);
+            if ((intptr_t)sequence - (intptr_t)(position + 1) < 0) { // Slot has not been filled yet, so the buffer is empty
+                return 0;
+            }
+            position = atomic_load_explicit(&myBuffer->consumerSide->position, memory_order_relaxed);
+            continue;
+        }
+        if (atomic_compare_exchange_weak_explicit(&myBuffer->consumerSide->position, &position, position + claimed, memory_order_relaxed, memory_order_relaxed)) {
+            break;
+        }
+    }
+    for (loopVar = 0; loopVar < claimed; loopVar++) {
+        Slot *slot = &myBuffer->slots[(position + loopVar) % myBuffer->slotCount];
+        items[loopVar] = slot->item;
+        atomic_store_explicit(&slot->sequence, position + loopVar + myBuffer->slotCount, memory_order_release);
+    }
+    return claimed;
+}
+
+// Sharded version of putBatch: empty slots are first reserved from the whole buffer, then filled in the shard of this producer
+// Only the reservation touches data shared by every producer, once per batch
+int putBatchToShards(Buffer *myBuffer, const int *items, int count) {
+    int freeSlots = atomic_load_explicit(&myBuffer->freeSlots->count, memory_order_relaxed);
+    int added;
+    if (producerTicket < 0) {
+        producerTicket = atomic_fetch_add(&myBuffer->nextProducerTicket, 1);
+    }
+    Buffer *shard = &myBuffer->shards[producerTicket % myBuffer->numberOfShards];
+    while (1) {
+        if (freeSlots == 0) {                // Every shard together is full
+            sched_yield();
+            freeSlots = atomic_load_explicit(&myBuffer->freeSlots->count, memory_order_relaxed);
+            continue;
+        }
+        if (count > freeSlots) {
+            count = freeSlots;
+        }
+        if (atomic_compare_exchange_weak_explicit(&myBuffer->freeSlots->count, &freeSlots, freeSlots - count, memory_order_relaxed, memory_order_relaxed)) {
+            break;
+        }
+    }
+    for (added = 0; added < count; ) {       // Reserved slots exist, but a consumer may still be copying out of the slot this shard reuses
+        int claimed = tryPutBatchMultiple(shard, items + added, count - added);
+        if (claimed == 0) {
+            sched_yield();
+        }
+        added += claimed;
+    }
+    return count;
+}
+
+// Sharded version of takeBatch that does not wait: the home shard of this consumer is tried first, then every other shard in turn
+// Returns 0 if every shard is empty
+int tryTakeBatchFromShards(Buffer *myBuffer, int *items, int maxCount) {
+    int removed, loopVar;
+    if (consumerTicket < 0) {
+        consumerTicket = atomic_fetch_add(&myBuffer->nextConsumerTicket, 1);
+    }
+    int homeShard = consumerTicket % myBuffer->numberOfShards;
+    for (loopVar = 0; loopVar < myBuffer->numberOfShards; loopVar++) {
+        removed = tryTakeBatchMultiple(&myBuffer->shards[(homeShard + loopVar) % myBuffer->numberOfShards], items, maxCount);
+        if (removed > 0) {
+            atomic_fetch_add_explicit(&myBuffer->freeSlots->count, removed, memory_order_release);
+            return removed;
+        }
+    }
+    return 0;
+}
+
+// Sharded version of takeBatch, which waits until some shard has an item
+int takeBatchFromShards(Buffer *myBuffer, int *items, int maxCount) {
+    int removed;
+    while ((removed = tryTakeBatchFromShards(myBuffer, items, maxCount)) == 0) {
+        sched_yield();                       // Every shard is empty
+    }
+    return removed;
+}
+
+// Returns 1 once every item added to a sharded buffer has been removed, since slots are only given back after their items are copied out
+int shardsAreEmpty(Buffer *myBuffer) {
+    return atomic_load_explicit(&myBuffer->freeSlots->count, memory_order_acquire) == myBuffer->bufferSize;
+}
+
+// Adds up to count items in one synchronization step, waiting until at least one slot is empty, and returns how many were added
+// With semaphores, the first empty slot is waited for and the rest are only taken if already free, then all of them are filled under one lock
+int putBatch(Buffer *myBuffer, const int *items, int count) {
+    int reserved = 1;
+    int loopVar;
+    if (myBuffer->mode == SHARDEDBUFFER) {
+        return putBatchToShards(myBuffer, items, count);
+    }
+    if (myBuffer->mode != SEMAPHOREBUFFER) {
+        while ((reserved = myBuffer->singleProducerSingleConsumer ? tryPutBatchSingle(myBuffer, items, count) : tryPutBatchMultiple(myBuffer, items, count)) == 0) {
+            sched_yield();
+        }
+        return reserved;
+    }
+    sem_wait(&myBuffer->emptySlot);          // Wait until there is at least one empty slot
+    while (reserved < count && sem_trywait(&myBuffer->emptySlot) == 0) {
+        reserved++;
+    }
+    pthread_mutex_lock(&myBuffer->mutexToAccessBuffer);
+    copyIntoRing(myBuffer->buffer, myBuffer->bufferSize, myBuffer->inIndex, items, reserved);
+    myBuffer->inIndex = (myBuffer->inIndex + reserved) % myBuffer->bufferSize;
+    myBuffer->bufferCount += reserved;
+    pthread_mutex_unlock(&myBuffer->mutexToAccessBuffer);
+    for (loopVar = 0; loopVar < reserved; loopVar++) {
+        sem_post(&myBuffer->fullSlot);       // POSIX has no way to post several at once
+    }
+    return reserved;
+}
+
+// Removes up to maxCount items in one synchronization step, waiting until at least one slot is filled, and returns how many were removed
+int takeBatch(Buffer *myBuffer, int *items, int maxCount) {
+    int reserved = 1;
+    int loopVar;
+    if (myBuffer->mode == SHARDEDBUFFER) {
+        return takeBatchFromShards(myBuffer, items, maxCount);
+    }
+    if (myBuffer->mode != SEMAPHOREBUFFER) {
+        while ((reserved = myBuffer->singleProducerSingleConsumer ? tryTakeBatchSingle(myBuffer, items, maxCount) : tryTakeBatchMultiple(myBuffer, items, maxCount)) == 0) {
+            sched_yield();
+        }
+        return reserved;
+    }
+    sem_wait(&myBuffer->fullSlot);           // Wait until there is at least one filled slot
+    while (reserved < maxCount && sem_trywait(&myBuffer->fullSlot) == 0) {
+        reserved++;
+    }
+    pthread_mutex_lock(&myBuffer->mutexToAccessBuffer);
+    copyFromRing(myBuffer->buffer, myBuffer->bufferSize, myBuffer->outIndex, items, reserved);
+    myBuffer->outIndex = (myBuffer->outIndex + reserved) % myBuffer->bufferSize;
+    myBuffer->bufferCount -= reserved;
+    pthread_mutex_unlock(&myBuffer->mutexToAccessBuffer);
+    for (loopVar = 0; loopVar < reserved; loopVar++) {
+        sem_post(&myBuffer->emptySlot);
+    }
+    return reserved;
+}
+
 // Producer thread function
 void *producer(void *arg) {
     Buffer *myBuffer = (Buffer *)arg;        // Cast the argument to a Buffer pointer
     int id = pthread_self() % 10000;         // Generate a pseudo-unique thread ID
 	srand(id);
+    int *items = (int *)malloc(myBuffer->batchSize * sizeof(int)); // Items of one batch
+    int loopVar, added;
     while (1) {                              // Infinite loop for continuous production
+        if (myBuffer->batchSize > 1) {       // Items are produced a batch at a time, and added with as few operations as the free slots allow
+            for (loopVar = 0; loopVar < myBuffer->batchSize; loopVar++) {
+                items[loopVar] = rand() % (1000 - 1 + 1) + 0;
+            }
+            for (loopVar = 0; loopVar < myBuffer->batchSize; loopVar += added) {
+                added = putBatch(myBuffer, items + loopVar, myBuffer->batchSize - loopVar);
+                printf("Producer %d added %d items.\n", id, added);
+            }
+            sleep(rand() % 3 + 1);
+            continue;
+        }
+        if (myBuffer->mode != SEMAPHOREBUFFER) { // Lock-free buffer has no lock to print the whole buffer under
+            int item = rand() % (1000 - 1 + 1) + 0;
+            putToLockFreeBuffer(myBuffer, item);
+            printf("Producer %d added item %d.\n", id, item);
+            sleep(rand() % 3 + 1);
+            continue;
+        }
         sem_wait(&myBuffer->emptySlot);      // Wait until there is at least one empty slot
         pthread_mutex_lock(&myBuffer->mutexToAccessBuffer); // Lock the mutex to access shared data safely
 
@@ -60,8 +642,21 @@ void *producer(void *arg) {
 void *consumer(void *arg) {
     Buffer *myBuffer = (Buffer *)arg;        // Cast the argument to a Buffer pointer
     int id = pthread_self() % 10000;         // Generate a pseudo-unique thread ID
+    int *items = (int *)malloc(myBuffer->batchSize * sizeof(int));
 
     while (1) {                              // Infinite loop for continuous consumption
+        if (myBuffer->batchSize > 1) {       // Takes whatever is in the buffer, up to a batch
+            int removed = takeBatch(myBuffer, items, myBuffer->batchSize);
+            printf("Consumer %d removed %d items, first %d and last %d.\n", id, removed, items[0], items[removed - 1]);
+            sleep(rand() % 3 + 1);
+            continue;
+        }
+        if (myBuffer->mode != SEMAPHOREBUFFER) {
+            int item = takeFromLockFreeBuffer(myBuffer);
+            printf("Consumer %d removed item %d.\n", id, item);
+            sleep(rand() % 3 + 1);
+            continue;
+        }
         sem_wait(&myBuffer->fullSlot);       // Wait until there is at least one filled slot
         pthread_mutex_lock(&myBuffer->mutexToAccessBuffer); // Lock the mutex to access shared data safely
 
@@ -85,9 +680,394 @@ void *consumer(void *arg) {
 }
 
 
-int main() {
+// Histogram of enqueue-to-dequeue latencies, with buckets that grow with the latency so its size does not depend on the number of items
+typedef struct {
+    long long buckets[LATENCY_BUCKETS];
+    long long count;
+    long long total;
+    int maximum;
+} LatencyHistogram;
+
+// State shared by every thread of one benchmark run
+typedef struct {
+    Buffer buffer;
+    struct timespec startTime;     // Timestamps carried by items are nanoseconds since this time
+    atomic_int stopProducing;      // Set when the duration of the run is over
+} BenchmarkRun;
+
+// State of one producer or consumer of the benchmark
+typedef struct {
+    BenchmarkRun *run;
+    long items;                    // Items this producer makes, or 0 to make items until the run is stopped
+    long long moved;               // Items this thread added or removed
+    LatencyHistogram latency;      // Latencies of the items this consumer removed
+} BenchmarkThread;
+
+long long nanosecondsSince(struct timespec *startTime) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - startTime->tv_sec) * 1000000000LL + (now.tv_nsec - startTime->tv_nsec);
+}
+
+int latencyBucket(int latency) {
+    int shift = 0;
+    while ((latency >> shift) >= 2 * LATENCY_SUB_BUCKETS) { // Shift until only the leading 5 bits remain
+        shift++;
+    }
+    return shift * LATENCY_SUB_BUCKETS + (latency >> shift);
+}
+
+int latencyBucketUpperBound(int index) {   // Largest latency that falls in the bucket
+    int shift, leadingBits;
+    if (index < 2 * LATENCY_SUB_BUCKETS) {
+        return index;
+    }
+    shift = index / LATENCY_SUB_BUCKETS - 1;
+    leadingBits = index - shift * LATENCY_SUB_BUCKETS;
+    return (int)((((long long)leadingBits + 1) << shift) - 1);
+}
+
+void addLatency(LatencyHistogram *histogram, int latency) {
+    histogram->buckets[latencyBucket(latency)]++;
+    histogram->count++;
+    histogram->total += latency;
+    if (latency > histogram->maximum) {
+        histogram->maximum = latency;
+    }
+}
+
+void mergeLatencies(LatencyHistogram *histogram, LatencyHistogram *other) {
+    int loopVar;
+    for (loopVar = 0; loopVar < LATENCY_BUCKETS; loopVar++) {
+        histogram->buckets[loopVar] += other->buckets[loopVar];
+    }
+    histogram->count += other->count;
+    histogram->total += other->total;
+    if (other->maximum > histogram->maximum) {
+        histogram->maximum = other->maximum;
+    }
+}
+
+// Smallest bucket bound below which at least perMille thousandths of the latencies fall (never more than the maximum)
+int latencyPercentile(LatencyHistogram *histogram, int perMille) {
+    long long rank = (histogram->count * perMille + 999) / 1000;
+    long long seen = 0;
+    int loopVar;
+    if (rank < 1) {
+        rank = 1;
+    }
+    for (loopVar = 0; loopVar < LATENCY_BUCKETS; loopVar++) {
+        seen += histogram->buckets[loopVar];
+        if (seen >= rank) {
+            int upperBound = latencyBucketUpperBound(loopVar);
+            return (upperBound < histogram->maximum) ? upperBound : histogram->maximum;
+        }
+    }
+    return histogram->maximum;
+}
+
+// Producer of the benchmark: no sleeping and no printing, each batch is stamped with the time it is added
+void *benchmarkProducer(void *arg) {
+    BenchmarkThread *thread = (BenchmarkThread *)arg;
+    Buffer *myBuffer = &thread->run->buffer;
+    int *items = (int *)malloc(myBuffer->batchSize * sizeof(int));
+    int count, added, loopVar;
+
+    while (thread->items > 0 ? thread->moved < thread->items : !atomic_load_explicit(&thread->run->stopProducing, memory_order_relaxed)) {
+        count = myBuffer->batchSize;
+        if (thread->items > 0 && thread->items - thread->moved < count) {
+            count = (int)(thread->items - thread->moved);
+        }
+        int timestamp = (int)(nanosecondsSince(&thread->run->startTime) & LATENCY_MASK);
+        for (loopVar = 0; loopVar < count; loopVar++) {
+            items[loopVar] = timestamp;
+        }
+        for (added = 0; added < count; ) {   // A batch may need several operations while the buffer is nearly full
+            added += putBatch(myBuffer, items + added, count - added);
+        }
+        thread->moved += count;
+    }
+    free(items);
+    return NULL;
+}
+
+// Consumer of the benchmark: records how long each item waited, until it removes the STOP_ITEM
+// The STOP_ITEM is put back before leaving, so that every other consumer also finds it, even one blocked waiting for a filled slot
+// In a sharded buffer the STOP_ITEM only follows the items of its own shard, so the other shards are emptied first without waiting on them
+void *benchmarkConsumer(void *arg) {
+    BenchmarkThread *thread = (BenchmarkThread *)arg;
+    Buffer *myBuffer = &thread->run->buffer;
+    int *items = (int *)malloc(myBuffer->batchSize * sizeof(int));
+    int stopItem = STOP_ITEM;
+    int stopped = 0;                         // 1 once this consumer holds the STOP_ITEM
+    int removed, loopVar;
+
+    while (1) {
+        removed = stopped ? tryTakeBatchFromShards(myBuffer, items, myBuffer->batchSize) : takeBatch(myBuffer, items, myBuffer->batchSize);
+        int now = (int)(nanosecondsSince(&thread->run->startTime) & LATENCY_MASK);
+        for (loopVar = 0; loopVar < removed; loopVar++) {
+            if (items[loopVar] == STOP_ITEM) {  // Added after every producer finished, so no other item of its queue follows it
+                stopped = 1;
+                continue;
+            }
+            addLatency(&thread->latency, (now - items[loopVar]) & LATENCY_MASK);
+            thread->moved++;
+        }
+        if (stopped && (myBuffer->mode != SHARDEDBUFFER || shardsAreEmpty(myBuffer))) {
+            putBatch(myBuffer, &stopItem, 1);
+            free(items);
+            return NULL;
+        }
+        if (stopped && removed == 0) {       // Other consumers are still copying their last items out
+            sched_yield();
+        }
+    }
+}
+
+// This function runs one configuration of the benchmark and prints its CSV row
+void runBenchmarkConfiguration(BufferMode mode, BufferLayout layout, int bufferSize, int numProducers, int numConsumers) {
+    BenchmarkRun run;
+    BenchmarkThread *producerThreads = (BenchmarkThread *)calloc(numProducers, sizeof(BenchmarkThread));
+    BenchmarkThread *consumerThreads = (BenchmarkThread *)calloc(numConsumers, sizeof(BenchmarkThread));
+    pthread_t *producers = (pthread_t *)malloc(numProducers * sizeof(pthread_t));
+    pthread_t *consumers = (pthread_t *)malloc(numConsumers * sizeof(pthread_t));
+    LatencyHistogram latency;
+    int stopItem = STOP_ITEM;
+    long long consumed = 0;
+    int startedProducers = 0, startedConsumers = 0;
+    int loopVar;
+
+    if (producerThreads == NULL || consumerThreads == NULL || producers == NULL || consumers == NULL) {
+        printf("Benchmark of %d producers and %d consumers cannot be started as there is no more memory.\n", numProducers, numConsumers);
+        free(producerThreads);
+        free(consumerThreads);
+        free(producers);
+        free(consumers);
+        return;
+    }
+    if (!initBuffer(&run.buffer, bufferSize, mode, layout, numProducers, numConsumers, options.batchSize)) { // Without the buffer this configuration has no row
+        free(producerThreads);
+        free(consumerThreads);
+        free(producers);
+        free(consumers);
+        return;
+    }
+    atomic_init(&run.stopProducing, 0);
+    memset(&latency, 0, sizeof(latency));
+    clock_gettime(CLOCK_MONOTONIC, &run.startTime);
+    for (loopVar = 0; loopVar < numConsumers; loopVar++) {
+        consumerThreads[loopVar].run = &run;
+        if (pthread_create(&consumers[loopVar], NULL, benchmarkConsumer, (void *)&consumerThreads[loopVar]) != 0) { // The run goes on with the consumers already started
+            break;
+        }
+        startedConsumers++;
+    }
+    for (loopVar = 0; loopVar < numProducers && startedConsumers > 0; loopVar++) { // Without a consumer, producers would wait forever on a full buffer
+        producerThreads[loopVar].run = &run;
+        producerThreads[loopVar].items = (options.duration > 0) ? 0 : options.items / numProducers + (loopVar < options.items % numProducers); // Items are split as evenly as possible
+        if (pthread_create(&producers[loopVar], NULL, benchmarkProducer, (void *)&producerThreads[loopVar]) != 0) { // The items of producers not started are never added
+            break;
+        }
+        startedProducers++;
+    }
+    if (options.duration > 0 && startedProducers > 0) {
+        struct timespec duration;
+        duration.tv_sec = (time_t)options.duration;
+        duration.tv_nsec = (long)((options.duration - duration.tv_sec) * 1e9);
+        nanosleep(&duration, NULL);
+        atomic_store(&run.stopProducing, 1);
+    }
+    for (loopVar = 0; loopVar < startedProducers; loopVar++) {
+        pthread_join(producers[loopVar], NULL);
+    }
+    if (startedConsumers > 0) {
+        putBatch(&run.buffer, &stopItem, 1); // Every item is already in the buffer, so consumers stop once they reach this one
+    }
+    for (loopVar = 0; loopVar < startedConsumers; loopVar++) {
+        pthread_join(consumers[loopVar], NULL);
+        mergeLatencies(&latency, &consumerThreads[loopVar].latency);
+        consumed += consumerThreads[loopVar].moved;
+    }
+    double seconds = nanosecondsSince(&run.startTime) / 1e9;
+
+    if (startedProducers == 0 || startedConsumers == 0) { // Nothing was moved, so there is nothing to measure
+        printf("Benchmark of %d producers and %d consumers cannot be run as no thread of one side could be started.\n", numProducers, numConsumers);
+    }
+    else {
+        // If only some threads could be started, the row shows how many ran, and its items are those they moved
+        printf("%s,%s,%d,%d,%d,%d,%lld,%.6f,%.0f,%.0f,%d,%d,%d,%d\n", bufferModeNames[mode], bufferLayoutNames[layout], options.batchSize, bufferSize, startedProducers, startedConsumers,
+            consumed, seconds, consumed / seconds, latency.count > 0 ? (double)latency.total / latency.count : 0.0,
+            latencyPercentile(&latency, 500), latencyPercentile(&latency, 990), latencyPercentile(&latency, 999), latency.maximum);
+    }
+    fflush(stdout);                          // Each row shows up as soon as its run is over
+
+    destroyBuffer(&run.buffer);
+    free(producerThreads);
+    free(consumerThreads);
+    free(producers);
+    free(consumers);
+}
+
+// This function runs every combination of buffer mode, layout, buffer size and thread counts, printed as CSV
+// The semaphore buffer only has the compact layout, since both sides take the same mutex and write the same semaphores anyway
+void runBenchmark(void) {
+    int modeIndex, layoutIndex, sizeIndex, threadIndex;
+    printf("buffer,layout,batch,buffer_size,producers,consumers,items,seconds,items_per_second,average_latency_ns,p50_latency_ns,p99_latency_ns,p999_latency_ns,max_latency_ns\n");
+    for (modeIndex = SEMAPHOREBUFFER; modeIndex <= SHARDEDBUFFER; modeIndex++) {
+        if (options.modeGiven && (BufferMode)modeIndex != options.mode) {
+            continue;
+        }
+        for (layoutIndex = COMPACTLAYOUT; layoutIndex <= PADDEDLAYOUT; layoutIndex++) {
+            if ((options.layoutGiven && (BufferLayout)layoutIndex != options.layout) || (modeIndex == SEMAPHOREBUFFER && layoutIndex == PADDEDLAYOUT)) {
+                continue;
+            }
+            for (sizeIndex = 0; sizeIndex < options.numberOfBufferSizes; sizeIndex++) {
+                for (threadIndex = 0; threadIndex < options.numberOfThreadCounts; threadIndex++) {
+                    runBenchmarkConfiguration((BufferMode)modeIndex, (BufferLayout)layoutIndex, options.bufferSizes[sizeIndex], options.producerCounts[threadIndex], options.consumerCounts[threadIndex]);
+                }
+            }
+        }
+    }
+}
+
+// Reads a comma-separated list of positive numbers, where each entry may also be a pair like 4x2 if second is not NULL
+// Entries without a pair use the same number for both
+int readList(char *text, int *first, int *second, int *count) {
+    char *end;
+    *count = 0;
+    do {
+        if (*count == MAX_SWEEP_VALUES) {
+            printf("At most %d values can be swept.\n", MAX_SWEEP_VALUES);
+            return 0;
+        }
+        first[*count] = (int)strtol(text, &end, 10);
+        if (end == text || first[*count] <= 0) {
+            return 0;
+        }
+        if (second != NULL) {
+            second[*count] = first[*count];
+            if (*end == 'x') {
+                text = end + 1;
+                second[*count] = (int)strtol(text, &end, 10);
+                if (end == text || second[*count] <= 0) {
+                    return 0;
+                }
+            }
+        }
+        if (*end != ',' && *end != '\0') {
+            return 0;
+        }
+        (*count)++;
+        text = end + 1;
+    } while (*end == ',');
+    return 1;
+}
+
+int readOptions(int argc, char *argv[]) {
+    int loopVar;
+    for (loopVar = 1; loopVar < argc; loopVar++) {
+        if (strcmp(argv[loopVar], "--buffer") == 0 && loopVar + 1 < argc) {
+            loopVar++;
+            options.modeGiven = 1;
+            if (strcmp(argv[loopVar], "semaphore") == 0) {
+                options.mode = SEMAPHOREBUFFER;
+            }
+            else if (strcmp(argv[loopVar], "lock-free") == 0) {
+                options.mode = LOCKFREEBUFFER;
+            }
+            else if (strcmp(argv[loopVar], "mpmc") == 0) {
+                options.mode = MPMCBUFFER;
+            }
+            else if (strcmp(argv[loopVar], "sharded") == 0) {
+                options.mode = SHARDEDBUFFER;
+            }
+            else {
+                printf("Unknown buffer: %s\n", argv[loopVar]);
+                return 0;
+            }
+        }
+        else if (strcmp(argv[loopVar], "--layout") == 0 && loopVar + 1 < argc) {
+            loopVar++;
+            options.layoutGiven = 1;
+            if (strcmp(argv[loopVar], "compact") == 0) {
+                options.layout = COMPACTLAYOUT;
+            }
+            else if (strcmp(argv[loopVar], "padded") == 0) {
+                options.layout = PADDEDLAYOUT;
+            }
+            else {
+                printf("Unknown layout: %s\n", argv[loopVar]);
+                return 0;
+            }
+        }
+        else if (strcmp(argv[loopVar], "--batch") == 0 && loopVar + 1 < argc) {
+            options.batchSize = atoi(argv[++loopVar]);
+            if (options.batchSize <= 0) {
+                printf("Batch size must be greater than zero.\n");
+                return 0;
+            }
+        }
+        else if (strcmp(argv[loopVar], "--benchmark") == 0) {
+            options.benchmark = 1;
+        }
+        else if (strcmp(argv[loopVar], "--items") == 0 && loopVar + 1 < argc) {
+            options.items = atol(argv[++loopVar]);
+            if (options.items <= 0) {
+                printf("Number of items must be greater than zero.\n");
+                return 0;
+            }
+        }
+        else if (strcmp(argv[loopVar], "--duration") == 0 && loopVar + 1 < argc) {
+            options.duration = atof(argv[++loopVar]);
+            if (options.duration <= 0) {
+                printf("Duration must be greater than zero.\n");
+                return 0;
+            }
+        }
+        else if (strcmp(argv[loopVar], "--sizes") == 0 && loopVar + 1 < argc) {
+            if (!readList(argv[++loopVar], options.bufferSizes, NULL, &options.numberOfBufferSizes)) {
+                printf("Buffer sizes must be greater than zero and separated by commas.\n");
+                return 0;
+            }
+        }
+        else if (strcmp(argv[loopVar], "--threads") == 0 && loopVar + 1 < argc) {
+            if (!readList(argv[++loopVar], options.producerCounts, options.consumerCounts, &options.numberOfThreadCounts)) {
+                printf("Thread counts must be greater than zero and separated by commas.\n");
+                return 0;
+            }
+        }
+        else {
+            printf("Unknown option: %s\n", argv[loopVar]);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+void printUsage(char *programName) {
+    printf("Usage: %s [options]\n", programName);
+    printf("  --buffer MODE       semaphore (default), lock-free, mpmc or sharded (the benchmark compares all of them unless this is given)\n");
+    printf("  --layout LAYOUT     Positions of the lock-free buffers: compact (default) or padded onto separate cache lines (the benchmark compares both unless this is given)\n");
+    printf("  --batch N           Items moved by each producer and consumer in one operation (default 1)\n");
+    printf("  --benchmark         Measure throughput and latency instead of asking for the buffer size and number of threads\n");
+    printf("  --items N           Items moved by each run of the benchmark (default 1000000)\n");
+    printf("  --duration SECONDS  Run each configuration of the benchmark for this long instead\n");
+    printf("  --sizes LIST        Buffer sizes swept by the benchmark (default 1,16,1024)\n");
+    printf("  --threads LIST      Thread counts swept by the benchmark, where N is N producers and N consumers and PxC is P producers and C consumers (default 1,2,4,8)\n");
+}
+
+int main(int argc, char *argv[]) {
     int bufferSize, numProducers, numConsumers, loopVar;
 
+    if (!readOptions(argc, argv)) {          // If an option is invalid, show how to use the program then exit
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (options.benchmark) {
+        runBenchmark();
+        return 0;
+    }
+
     // Get user input for buffer size, number of producers, and consumers
     do{
     	printf("Enter buffer size: ");
@@ -108,18 +1088,9 @@ int main() {
 
     // Initialize the buffer and synchronization primitives
     Buffer myBuffer;
-    myBuffer.bufferSize = bufferSize;
-    myBuffer.buffer = (int *)malloc(bufferSize * sizeof(int)); // Allocate memory for the buffer
-    
-    for(loopVar = 0; loopVar< bufferSize; loopVar++){
-    	myBuffer.buffer[loopVar] = 0;
-	}
-    myBuffer.inIndex = 0;             // Initialize producer index
-    myBuffer.outIndex = 0;            // Initialize consumer index
-    myBuffer.bufferCount = 0;         // Initialize item count
-    sem_init(&myBuffer.fullSlot, 0, 0); // Initialize "full" semaphore with 0 (no items initially)
-    sem_init(&myBuffer.emptySlot, 0, bufferSize); // Initialize "empty" semaphore with the buffer size
-    pthread_mutex_init(&myBuffer.mutexToAccessBuffer, NULL); // Initialize the mutex
+    if (!initBuffer(&myBuffer, bufferSize, options.mode, options.layout, numProducers, numConsumers, options.batchSize)) {
+        return 1;
+    }
 
     // Allocate memory for producer and consumer thread handles
     pthread_t *producers = (pthread_t *)malloc(numProducers * sizeof(pthread_t));
@@ -146,12 +1117,9 @@ int main() {
     }
 
     // Free allocated resources and destroy synchronization primitives
-    free(myBuffer.buffer);                  // Free the buffer memory
+    destroyBuffer(&myBuffer);               // Free the buffer memory and destroy its synchronization primitives
     free(producers);                        // Free producer thread handles
     free(consumers);                        // Free consumer thread handles
-    sem_destroy(&myBuffer.fullSlot);        // Destroy the "full" semaphore
-    sem_destroy(&myBuffer.emptySlot);       // Destroy the "empty" semaphore
-    pthread_mutex_destroy(&myBuffer.mutexToAccessBuffer); // Destroy the mutex
 
     return 0; // Exit the program
 }